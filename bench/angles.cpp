@@ -0,0 +1,57 @@
+#include "bench.h"
+
+#include "radian_degree.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+// Values per second of the angle array kernels next to the scalar Degree and
+// Radian conversions they replace, and of parse_dms/format_dms.
+int main(int argc, char **argv) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    std::vector<WGS84> points = worldwide_points(count);
+    std::vector<double> degrees(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        degrees[i] = points[i].longitude;
+    }
+    std::vector<double> radians(count);
+
+    double sink = 0;
+    auto report = [](const char *kernel, std::size_t values, double seconds) {
+        std::printf("%-28s %8.2f Mvalues/s\n", kernel, values / seconds * 1e-6);
+    };
+    report("scalar degrees -> radians", count, best_seconds([&] {
+               for (std::size_t i = 0; i < count; ++i) {
+                   radians[i] = Radian{Degree{degrees[i]}};
+               }
+               sink += radians[count / 2];
+           }));
+    report("degrees_to_radians", count, best_seconds([&] {
+               degrees_to_radians(degrees.data(), radians.data(), count);
+               sink += radians[count / 2];
+           }));
+    report("scalar radians -> degrees", count, best_seconds([&] {
+               for (std::size_t i = 0; i < count; ++i) {
+                   degrees[i] = Degree{Radian{radians[i]}};
+               }
+               sink += degrees[count / 2];
+           }));
+    report("radians_to_degrees", count, best_seconds([&] {
+               radians_to_degrees(radians.data(), degrees.data(), count);
+               sink += degrees[count / 2];
+           }));
+
+    // Text is slower by orders of magnitude; a tenth of the values is enough.
+    std::size_t texts = count / 10;
+    std::vector<std::string> text(texts);
+    report("format_dms", texts, best_seconds([&] {
+               for (std::size_t i = 0; i < texts; ++i) {
+                   text[i] = format_dms(degrees[i]);
+               }
+           }));
+    report("parse_dms", texts, best_seconds([&] {
+               sink += parse_dms(text.data(), radians.data(), texts);
+           }));
+    return sink == 0;
+}
@@ -0,0 +1,38 @@
+#ifndef TRANSFORMATION_BENCH_BENCH_H_
+#define TRANSFORMATION_BENCH_BENCH_H_
+
+#include "transformations.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// Best wall time of five runs of `run`, in seconds.
+template <class Run>
+double best_seconds(Run run) {
+    double best = 1e300;
+    for (int i = 0; i < 5; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        run();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// Uniformly shuffled points over the UTM latitude range, the same for every run.
+inline std::vector<WGS84> worldwide_points(std::size_t count) {
+    std::mt19937_64 random(42);
+    std::uniform_real_distribution<double> latitude(-80, 84);
+    std::uniform_real_distribution<double> longitude(-180, 180);
+    std::vector<WGS84> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        points.push_back(WGS84{Degree{latitude(random)}, Degree{longitude(random)}, 0});
+    }
+    return points;
+}
+
+#endif  // TRANSFORMATION_BENCH_BENCH_H_
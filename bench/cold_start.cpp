@@ -0,0 +1,74 @@
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern char **environ;
+
+namespace {
+
+// One WGS84 -> Gauss-Kruger conversion, the shortest useful CLI session.
+const char input[] = "1\n55.75\n37.62\n150\n";
+
+// Wall time of one run of `binary` from spawn to exit, in seconds; negative
+// if it could not be run or failed.
+double run_once(const char *binary) {
+    int pipe_fds[2];
+    if (pipe(pipe_fds) != 0) {
+        return -1;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipe_fds[0], 0);
+    posix_spawn_file_actions_addclose(&actions, pipe_fds[1]);
+    posix_spawn_file_actions_addopen(&actions, 1, "/dev/null", O_WRONLY, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    char *argv[] = {const_cast<char *>(binary), nullptr};
+    pid_t pid = 0;
+    int spawned = posix_spawn(&pid, binary, &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipe_fds[0]);
+    if (spawned == 0 && write(pipe_fds[1], input, std::strlen(input)) < 0) {
+        spawned = -1;
+    }
+    close(pipe_fds[1]);
+    int status = 0;
+    if (spawned != 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return -1;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+}  // namespace
+
+// Start-up cost of short-lived CLI runs: spawns the command-line converter
+// for a single conversion, repeatedly, and prints the best and median wall
+// time. Pass another build's binary to compare, e.g.
+// bench_cold_start old-build/main 500.
+int main(int argc, char **argv) {
+    const char *binary = argc > 1 ? argv[1] : TRANSFORMATIONS_MAIN;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    std::vector<double> times;
+    for (int i = 0; i < runs; ++i) {
+        double seconds = run_once(binary);
+        if (seconds < 0) {
+            std::fprintf(stderr, "could not run %s\n", binary);
+            return 1;
+        }
+        times.push_back(seconds);
+    }
+    std::sort(times.begin(), times.end());
+    std::printf("%s, %d runs: best %.0f us, median %.0f us\n", binary, runs, times.front() * 1e6,
+                times[times.size() / 2] * 1e6);
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "bench.h"
+
+#include "batch.h"
+#include "transformations_c.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// Cost of going through the C entry points instead of the C++ batch APIs, per
+// batch, for batch sizes from a single point up. The C side reads and writes
+// caller columns; the C++ side builds its result vectors.
+int main(int argc, char **argv) {
+    std::size_t total = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1 << 20;
+    std::vector<WGS84> all = worldwide_points(total);
+
+    std::size_t sink = 0;
+    for (std::size_t size : {std::size_t{1}, std::size_t{16}, std::size_t{256}, std::size_t{4096}, total}) {
+        std::vector<WGS84> points(all.begin(), all.begin() + size);
+        std::vector<double> latitude, longitude, altitude;
+        for (const WGS84 &point : points) {
+            latitude.push_back(point.latitude);
+            longitude.push_back(point.longitude);
+            altitude.push_back(point.altitude);
+        }
+        std::vector<double> out0(size), out1(size), out2(size);
+        std::vector<std::int32_t> zone_number(size);
+        std::vector<char> zone_letter(size);
+        std::vector<std::uint8_t> status(size);
+        auto in = [](const std::vector<double> &values) {
+            return transformations_column{values.data(), sizeof(double)};
+        };
+        auto out = [](std::vector<double> &values) {
+            return transformations_mutable_column{values.data(), sizeof(double)};
+        };
+        std::size_t batches = total / size;
+
+        double cpp_gk = best_seconds([&] {
+            for (std::size_t b = 0; b < batches; ++b) {
+                sink += to_gauss_kruger(points, status).size();
+            }
+        });
+        double c_gk = best_seconds([&] {
+            for (std::size_t b = 0; b < batches; ++b) {
+                sink += transformations_wgs84_to_gauss_kruger(size, in(latitude), in(longitude), in(altitude),
+                                                              out(out0), out(out1), out(out2), status.data());
+            }
+        });
+        double cpp_utm = best_seconds([&] {
+            for (std::size_t b = 0; b < batches; ++b) {
+                sink += to_utm(points, status).size();
+            }
+        });
+        double c_utm = best_seconds([&] {
+            for (std::size_t b = 0; b < batches; ++b) {
+                sink += transformations_wgs84_to_utm(
+                    size, in(latitude), in(longitude), in(altitude), out(out0), out(out1), out(out2),
+                    transformations_mutable_column{zone_number.data(), sizeof(std::int32_t)},
+                    transformations_mutable_column{zone_letter.data(), sizeof(char)}, status.data());
+            }
+        });
+        auto per_batch = [batches](double seconds) { return seconds / batches * 1e9; };
+        std::printf("%8zu points/batch: gauss-kruger C++ %10.0f ns, C %10.0f ns; utm C++ %10.0f ns, C %10.0f ns\n",
+                    size, per_batch(cpp_gk), per_batch(c_gk), per_batch(cpp_utm), per_batch(c_utm));
+    }
+    return sink == 0;
+}
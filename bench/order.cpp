@@ -0,0 +1,22 @@
+#include "bench.h"
+
+#include "batch.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+// Compares ORDER::INPUT with ORDER::SPACE_FILLING_CURVE on shuffled worldwide
+// points, where the zone branches are least predictable.
+int main(int argc, char **argv) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    std::vector<WGS84> points = worldwide_points(count);
+
+    std::size_t sink = 0;
+    for (ORDER order : {ORDER::INPUT, ORDER::SPACE_FILLING_CURVE}) {
+        double gk = best_seconds([&] { sink += to_gauss_kruger(points, order).size(); });
+        double utm = best_seconds([&] { sink += to_utm(points, order).size(); });
+        std::printf("%-20s %zu points: gauss-kruger %.3f s, utm %.3f s\n",
+                    order == ORDER::INPUT ? "input" : "space-filling curve", count, gk, utm);
+    }
+    return sink == 0;
+}
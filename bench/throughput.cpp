@@ -0,0 +1,58 @@
+#include "bench.h"
+
+#include "batch.h"
+#include "fixed_math.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+// The elementary functions of one projection, from libm or from fixed_math:
+// the part of the per-point cost TRANSFORMATIONS_DETERMINISTIC changes.
+template <class Sin, class Cos, class Atan2, class Pow>
+double elementary(const std::vector<WGS84> &points, Sin sin, Cos cos, Atan2 atan2, Pow pow) {
+    double sum = 0;
+    for (const WGS84 &point : points) {
+        double B = point.latitude * 0.017453292519943295;
+        double L = point.longitude * 0.017453292519943295;
+        sum += sin(B) * cos(L) + atan2(sin(L), cos(B)) + pow(cos(B), 5.0);
+    }
+    return sum;
+}
+
+}  // namespace
+
+// Points per second of the four batch routes, to compare build presets:
+// build each preset with -DTRANSFORMATIONS_BENCHMARKS=ON and run this binary;
+// with and without -DTRANSFORMATIONS_DETERMINISTIC=ON for the cost of that
+// mode. The last two lines time the functions it swaps, libm against
+// fixed_math, in any build.
+int main(int argc, char **argv) {
+    std::size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    std::vector<WGS84> points = worldwide_points(count);
+    std::vector<GaussKruger> gk = to_gauss_kruger(points);
+    std::vector<UTM> utm = to_utm(points);
+
+    std::size_t sink = 0;
+    auto report = [count](const char *route, double seconds) {
+        std::printf("%-22s %6.2f Mpoints/s\n", route, count / seconds * 1e-6);
+    };
+    report("wgs84 -> gauss-kruger", best_seconds([&] { sink += to_gauss_kruger(points).size(); }));
+    report("wgs84 -> utm", best_seconds([&] { sink += to_utm(points).size(); }));
+    report("gauss-kruger -> wgs84", best_seconds([&] { sink += to_wgs84(gk).size(); }));
+    report("utm -> wgs84", best_seconds([&] { sink += to_wgs84(utm).size(); }));
+
+    double sum = 0;
+    report("elementary, libm", best_seconds([&] {
+        sum += elementary(
+            points, [](double x) { return std::sin(x); }, [](double x) { return std::cos(x); },
+            [](double y, double x) { return std::atan2(y, x); }, [](double x, double y) { return std::pow(x, y); });
+    }));
+    report("elementary, fixed_math", best_seconds([&] {
+        sum += elementary(points, fixed_math::sin, fixed_math::cos, fixed_math::atan2, fixed_math::pow);
+    }));
+    sink += sum != 0;
+    return sink == 0;
+}
@@ -0,0 +1,111 @@
+#ifndef TRANSFORMATION_LIB_ASYNC_BATCH_H_
+#define TRANSFORMATION_LIB_ASYNC_BATCH_H_
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Handle of a conversion running on the shared thread pool. Destroying the
+// handle waits for the job, so callbacks never outlive it. Do not wait from
+// inside a job's callbacks.
+class ConversionJob {
+ public:
+    // Shared by the handle and the pool task.
+    struct State {
+        std::atomic<bool> cancelled{false};
+        std::mutex mutex;
+        std::condition_variable finished_signal;
+        bool finished = false;
+    };
+
+    ConversionJob() = default;
+    explicit ConversionJob(std::shared_ptr<State> state) : _state(std::move(state)) {}
+    ConversionJob(ConversionJob &&) = default;
+    ConversionJob &operator=(ConversionJob &&other) {
+        wait();
+        _state = std::move(other._state);
+        return *this;
+    }
+    ~ConversionJob() { wait(); }
+
+    // Stops the job before the next chunk; the chunk in flight is finished.
+    void cancel() {
+        if (_state) {
+            _state->cancelled = true;
+        }
+    }
+    void wait() {
+        if (_state) {
+            std::unique_lock<std::mutex> lock(_state->mutex);
+            _state->finished_signal.wait(lock, [this] { return _state->finished; });
+        }
+    }
+
+ private:
+    std::shared_ptr<State> _state;
+};
+
+// The pool task of convert_async(); it owns the points and the callbacks.
+template <class Out, class In, class OnChunk, class OnDone>
+struct ConversionTask {
+    std::vector<In> points;
+    std::vector<Out> (*convert)(const std::vector<In> &);
+    std::size_t chunk_size;
+    OnChunk on_chunk;
+    OnDone on_done;
+    std::shared_ptr<ConversionJob::State> state;
+
+    void operator()() {
+        bool completed = true;
+        for (std::size_t begin = 0; begin < points.size(); begin += chunk_size) {
+            if (state->cancelled) {
+                completed = false;
+                break;
+            }
+            std::size_t end = std::min(points.size(), begin + chunk_size);
+            if (begin == 0 && end == points.size()) {
+                on_chunk(begin, convert(points));
+            } else {
+                on_chunk(begin, convert(std::vector<In>(points.begin() + begin, points.begin() + end)));
+            }
+        }
+        on_done(completed);
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->finished = true;
+        state->finished_signal.notify_all();
+    }
+};
+
+// Converts `points` with one of the batch functions from batch.h without
+// blocking the caller, e.g. convert_async<UTM>(std::move(points), to_utm,
+// 4096, on_chunk). The input is split into chunks of `chunk_size` points;
+// `on_chunk(offset, converted)` receives the offset of each chunk and its
+// converted points. It runs on the pool thread, so a slow consumer throttles
+// the conversion instead of letting results pile up. `on_done(bool)` is
+// called once with `true` if every chunk was converted and `false` if the job
+// was cancelled. Jobs beyond the pool's worker count wait in its queue.
+template <class Out, class In, class OnChunk, class OnDone>
+ConversionJob convert_async(std::vector<In> points, std::vector<Out> (*convert)(const std::vector<In> &),
+                            std::size_t chunk_size, OnChunk on_chunk, OnDone on_done) {
+    auto state = std::make_shared<ConversionJob::State>();
+    std::shared_ptr<ConversionTask<Out, In, OnChunk, OnDone>> task(new ConversionTask<Out, In, OnChunk, OnDone>{
+        std::move(points), convert, std::max<std::size_t>(chunk_size, 1), std::move(on_chunk), std::move(on_done),
+        state});
+    ThreadPool::shared().submit([task] { (*task)(); });
+    return ConversionJob{std::move(state)};
+}
+
+template <class Out, class In, class OnChunk>
+ConversionJob convert_async(std::vector<In> points, std::vector<Out> (*convert)(const std::vector<In> &),
+                            std::size_t chunk_size, OnChunk on_chunk) {
+    return convert_async(std::move(points), convert, chunk_size, std::move(on_chunk), [](bool) {});
+}
+
+#endif  // TRANSFORMATION_LIB_ASYNC_BATCH_H_
@@ -0,0 +1,87 @@
+#ifndef TRANSFORMATION_LIB_ASYNC_BATCH_CORO_H_
+#define TRANSFORMATION_LIB_ASYNC_BATCH_CORO_H_
+
+// C++20 coroutine interface to the batch conversions. Needs the
+// transformations_coro target (TRANSFORMATIONS_COROUTINES=ON).
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+// Converts a batch chunk by chunk on the shared thread pool:
+//
+//     ConversionStream<UTM, WGS84> stream(std::move(points), to_utm, 4096);
+//     while (auto chunk = co_await stream.next()) {
+//         consume(chunk->offset, chunk->points);
+//     }
+//
+// A chunk is converted only when the coroutine asks for it, so at most one
+// chunk is in flight and a slow consumer holds the conversion back. The
+// coroutine resumes on the pool thread that converted the chunk; an event
+// loop service would post back to its own thread from there. next() yields
+// nothing once every chunk has been delivered or after cancel(). The stream
+// must not be destroyed while a next() is pending.
+template <class Out, class In>
+class ConversionStream {
+ public:
+    struct Chunk {
+        std::size_t offset;
+        std::vector<Out> points;
+    };
+
+    ConversionStream(std::vector<In> points, std::vector<Out> (*convert)(const std::vector<In> &),
+                     std::size_t chunk_size)
+        : _points(std::move(points)), _convert(convert), _chunk_size(std::max<std::size_t>(chunk_size, 1)) {}
+    ConversionStream(const ConversionStream &) = delete;
+    ConversionStream &operator=(const ConversionStream &) = delete;
+
+    // Stops before the next chunk; a chunk in flight is still delivered.
+    void cancel() { _cancelled = true; }
+
+    class Next {
+     public:
+        explicit Next(ConversionStream &stream) : _stream(stream) {}
+
+        bool await_ready() const noexcept { return _stream.finished(); }
+        void await_suspend(std::coroutine_handle<> caller) {
+            ThreadPool::shared().submit([this, caller] {
+                _stream.convert_next(_chunk);
+                caller.resume();
+            });
+        }
+        std::optional<Chunk> await_resume() { return std::move(_chunk); }
+
+     private:
+        ConversionStream &_stream;
+        std::optional<Chunk> _chunk;
+    };
+
+    Next next() { return Next{*this}; }
+
+ private:
+    bool finished() const { return _cancelled || _begin >= _points.size(); }
+
+    void convert_next(std::optional<Chunk> &chunk) {
+        std::size_t end = std::min(_points.size(), _begin + _chunk_size);
+        if (_begin == 0 && end == _points.size()) {
+            chunk = Chunk{0, _convert(_points)};
+        } else {
+            chunk = Chunk{_begin, _convert(std::vector<In>(_points.begin() + _begin, _points.begin() + end))};
+        }
+        _begin = end;
+    }
+
+    std::vector<In> _points;
+    std::vector<Out> (*_convert)(const std::vector<In> &);
+    std::size_t _chunk_size;
+    std::size_t _begin = 0;
+    std::atomic<bool> _cancelled{false};
+};
+
+#endif  // TRANSFORMATION_LIB_ASYNC_BATCH_CORO_H_
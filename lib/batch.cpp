@@ -0,0 +1,286 @@
+#include "batch.h"
+
+#include "geoid.h"
+#include "stats.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+template <class Out, class In, class Convert>
+std::vector<Out> convert(const std::vector<In> &points, Convert convert_one) {
+    std::vector<Out> result;
+    result.reserve(points.size());
+    for (const In &point : points) {
+        result.push_back(convert_one(point));
+    }
+    return result;
+}
+
+// Interleaves the bits of two 16-bit values.
+std::uint32_t morton(std::uint32_t a, std::uint32_t b) {
+    auto spread = [](std::uint32_t v) {
+        v = (v | (v << 8)) & 0x00ff00ff;
+        v = (v | (v << 4)) & 0x0f0f0f0f;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    };
+    return spread(a) | (spread(b) << 1);
+}
+
+template <class Point>
+std::uint32_t curve_key(const Point &point) {
+    double latitude = point.latitude;
+    double longitude = point.longitude;
+    // Out-of-range and NaN coordinates end up in the first cell.
+    auto quantize = [](double value, double low, double span) {
+        double q = (value - low) / span * 65535;
+        return q >= 0 && q <= 65535 ? static_cast<std::uint32_t>(q) : 0u;
+    };
+    return morton(quantize(longitude, -180, 360), quantize(latitude, -90, 180));
+}
+
+// Indices of `points` sorted by curve key, using a two-pass LSD radix sort.
+// Indices are 32-bit to halve the sort traffic; callers fall back to input
+// order for larger inputs.
+template <class Point>
+std::vector<std::uint32_t> curve_order(const std::vector<Point> &points) {
+    std::size_t n = points.size();
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> keys(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        keys[i] = std::make_pair(curve_key(points[i]), static_cast<std::uint32_t>(i));
+    }
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> sorted(n);
+    for (int shift = 0; shift < 32; shift += 16) {
+        std::vector<std::size_t> offsets(1 << 16, 0);
+        for (const auto &key : keys) {
+            ++offsets[(key.first >> shift) & 0xffff];
+        }
+        std::size_t total = 0;
+        for (std::size_t &offset : offsets) {
+            std::size_t count = offset;
+            offset = total;
+            total += count;
+        }
+        for (const auto &key : keys) {
+            sorted[offsets[(key.first >> shift) & 0xffff]++] = key;
+        }
+        keys.swap(sorted);
+    }
+    std::vector<std::uint32_t> order(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        order[i] = keys[i].second;
+    }
+    return order;
+}
+
+template <class Out, class In, class Convert>
+std::vector<Out> convert(const std::vector<In> &points, Convert convert_one, ORDER order, const Out &blank) {
+    if (order == ORDER::INPUT || points.size() > std::numeric_limits<std::uint32_t>::max()) {
+        return convert<Out>(points, convert_one);
+    }
+    std::vector<Out> result(points.size(), blank);
+    for (std::uint32_t i : curve_order(points)) {
+        result[i] = convert_one(points[i]);
+    }
+    return result;
+}
+
+// Validation runs as its own loop of comparisons ahead of the conversion.
+template <class Out, class In, class Convert, class Validate>
+std::vector<Out> convert(const std::vector<In> &points, Convert convert_one, Validate validate_one,
+                         std::vector<std::uint8_t> &status) {
+    status.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        status[i] = validate_one(points[i]);
+    }
+    std::vector<Out> result = convert<Out>(points, convert_one);
+    for (std::size_t i = 0; i < result.size(); ++i) {
+        // Valid input can still land outside the zone range, e.g. Gauss-Kruger
+        // west of Greenwich.
+        status[i] |= validate(result[i]) & (STATUS_NON_FINITE | STATUS_INVALID_ZONE);
+    }
+    return result;
+}
+
+std::uint8_t validate_geodetic(const WGS84 &wgs_84) {
+    return validate(wgs_84);
+}
+std::uint8_t validate_for_utm(const WGS84 &wgs_84) {
+    return validate(wgs_84, true);
+}
+std::uint8_t validate_gauss_kruger(const GaussKruger &gk) {
+    return validate(gk);
+}
+std::uint8_t validate_utm(const UTM &utm) {
+    return validate(utm);
+}
+
+GaussKruger gauss_kruger_from_wgs84(const WGS84 &wgs_84) {
+    return GaussKruger{SK42{wgs_84}};
+}
+GaussKruger gauss_kruger_from_pz90(const PZ90 &pz_90) {
+    return GaussKruger{SK42{WGS84{pz_90}}};
+}
+UTM utm_from_wgs84(const WGS84 &wgs_84) {
+    return UTM{wgs_84};
+}
+UTM utm_from_pz90(const PZ90 &pz_90) {
+    return UTM{WGS84{pz_90}};
+}
+WGS84 wgs84_from_gauss_kruger(const GaussKruger &gk) {
+    return WGS84{SK42{gk}};
+}
+WGS84 wgs84_from_utm(const UTM &utm) {
+    return WGS84{utm};
+}
+PZ90 pz90_from_gauss_kruger(const GaussKruger &gk) {
+    return PZ90{WGS84{SK42{gk}}};
+}
+PZ90 pz90_from_utm(const UTM &utm) {
+    return PZ90{WGS84{utm}};
+}
+
+}  // namespace
+
+std::vector<GaussKruger> to_gauss_kruger(const std::vector<WGS84> &wgs_84) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_GAUSS_KRUGER, wgs_84.size());
+    return convert<GaussKruger>(wgs_84, gauss_kruger_from_wgs84);
+}
+std::vector<GaussKruger> to_gauss_kruger(const std::vector<PZ90> &pz_90) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_GAUSS_KRUGER, pz_90.size());
+    return convert<GaussKruger>(pz_90, gauss_kruger_from_pz90);
+}
+std::vector<UTM> to_utm(const std::vector<WGS84> &wgs_84) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_UTM, wgs_84.size());
+    return convert<UTM>(wgs_84, utm_from_wgs84);
+}
+std::vector<UTM> to_utm(const std::vector<PZ90> &pz_90) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_UTM, pz_90.size());
+    return convert<UTM>(pz_90, utm_from_pz90);
+}
+std::vector<WGS84> to_wgs84(const std::vector<GaussKruger> &gk) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_WGS84, gk.size());
+    return convert<WGS84>(gk, wgs84_from_gauss_kruger);
+}
+std::vector<WGS84> to_wgs84(const std::vector<UTM> &utm) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_WGS84, utm.size());
+    return convert<WGS84>(utm, wgs84_from_utm);
+}
+std::vector<PZ90> to_pz90(const std::vector<GaussKruger> &gk) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_PZ90, gk.size());
+    return convert<PZ90>(gk, pz90_from_gauss_kruger);
+}
+std::vector<PZ90> to_pz90(const std::vector<UTM> &utm) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_PZ90, utm.size());
+    return convert<PZ90>(utm, pz90_from_utm);
+}
+
+std::vector<GaussKruger> to_gauss_kruger(const std::vector<WGS84> &wgs_84, ORDER order) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_GAUSS_KRUGER, wgs_84.size());
+    return convert(wgs_84, gauss_kruger_from_wgs84, order, GaussKruger{});
+}
+std::vector<GaussKruger> to_gauss_kruger(const std::vector<PZ90> &pz_90, ORDER order) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_GAUSS_KRUGER, pz_90.size());
+    return convert(pz_90, gauss_kruger_from_pz90, order, GaussKruger{});
+}
+std::vector<UTM> to_utm(const std::vector<WGS84> &wgs_84, ORDER order) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_UTM, wgs_84.size());
+    return convert(wgs_84, utm_from_wgs84, order, UTM{Degree{0.0}, Degree{0.0}, 0, ""});
+}
+std::vector<UTM> to_utm(const std::vector<PZ90> &pz_90, ORDER order) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_UTM, pz_90.size());
+    return convert(pz_90, utm_from_pz90, order, UTM{Degree{0.0}, Degree{0.0}, 0, ""});
+}
+
+std::vector<GaussKruger> to_gauss_kruger(const std::vector<WGS84> &wgs_84, std::vector<GridFactors> &factors) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_GAUSS_KRUGER, wgs_84.size());
+    std::vector<GaussKruger> result;
+    result.reserve(wgs_84.size());
+    factors.resize(wgs_84.size());
+    for (std::size_t i = 0; i < wgs_84.size(); ++i) {
+        result.push_back(GaussKruger{SK42{wgs_84[i]}, factors[i]});
+    }
+    return result;
+}
+std::vector<UTM> to_utm(const std::vector<WGS84> &wgs_84, std::vector<GridFactors> &factors) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_UTM, wgs_84.size());
+    std::vector<UTM> result;
+    result.reserve(wgs_84.size());
+    factors.resize(wgs_84.size());
+    for (std::size_t i = 0; i < wgs_84.size(); ++i) {
+        result.push_back(UTM{wgs_84[i], factors[i]});
+    }
+    return result;
+}
+
+std::vector<GaussKruger> to_gauss_kruger(const std::vector<WGS84> &wgs_84, std::vector<Jacobian> &jacobians) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_GAUSS_KRUGER_JACOBIAN, wgs_84.size());
+    std::vector<GaussKruger> result;
+    result.reserve(wgs_84.size());
+    jacobians.resize(wgs_84.size());
+    for (std::size_t i = 0; i < wgs_84.size(); ++i) {
+        result.push_back(GaussKruger{SK42{wgs_84[i]}, jacobians[i]});
+    }
+    return result;
+}
+std::vector<GaussKruger> to_gauss_kruger(const std::vector<WGS84> &wgs_84, const std::vector<Covariance> &covariances,
+                                         std::vector<Covariance> &projected) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_GAUSS_KRUGER_JACOBIAN, wgs_84.size());
+    if (covariances.size() != wgs_84.size()) {
+        throw std::invalid_argument("to_gauss_kruger: one covariance per point expected");
+    }
+    std::vector<GaussKruger> result;
+    result.reserve(wgs_84.size());
+    projected.resize(wgs_84.size());
+    for (std::size_t i = 0; i < wgs_84.size(); ++i) {
+        Jacobian jacobian;
+        result.push_back(GaussKruger{SK42{wgs_84[i]}, jacobian});
+        projected[i] = propagate(jacobian, covariances[i]);
+    }
+    return result;
+}
+
+std::vector<GaussKruger> to_gauss_kruger(const std::vector<WGS84> &wgs_84, std::vector<std::uint8_t> &status) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_GAUSS_KRUGER, wgs_84.size());
+    return convert<GaussKruger>(wgs_84, gauss_kruger_from_wgs84, validate_geodetic, status);
+}
+std::vector<UTM> to_utm(const std::vector<WGS84> &wgs_84, std::vector<std::uint8_t> &status) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_UTM, wgs_84.size());
+    return convert<UTM>(wgs_84, utm_from_wgs84, validate_for_utm, status);
+}
+std::vector<WGS84> to_wgs84(const std::vector<GaussKruger> &gk, std::vector<std::uint8_t> &status) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_WGS84, gk.size());
+    return convert<WGS84>(gk, wgs84_from_gauss_kruger, validate_gauss_kruger, status);
+}
+std::vector<WGS84> to_wgs84(const std::vector<UTM> &utm, std::vector<std::uint8_t> &status) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_WGS84, utm.size());
+    return convert<WGS84>(utm, wgs84_from_utm, validate_utm, status);
+}
+
+std::vector<GaussKruger> to_gauss_kruger(const std::vector<WGS84> &wgs_84, const GeoidGrid &geoid) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_GAUSS_KRUGER, wgs_84.size());
+    std::vector<GaussKruger> result;
+    result.reserve(wgs_84.size());
+    for (const WGS84 &point : wgs_84) {
+        GaussKruger gk{SK42{point}};
+        gk.height -= geoid.undulation(point.latitude, point.longitude);
+        result.push_back(gk);
+    }
+    return result;
+}
+std::vector<UTM> to_utm(const std::vector<WGS84> &wgs_84, const GeoidGrid &geoid) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_UTM, wgs_84.size());
+    std::vector<UTM> result;
+    result.reserve(wgs_84.size());
+    for (const WGS84 &point : wgs_84) {
+        UTM utm{point};
+        utm.altitude -= geoid.undulation(point.latitude, point.longitude);
+        result.push_back(std::move(utm));
+    }
+    return result;
+}
@@ -0,0 +1,406 @@
+#include "codec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+
+namespace {
+
+constexpr double metre_scale = 1000;
+constexpr double degree_scale = 1e8;
+
+enum class KIND : std::uint8_t { WGS84 = 1, GAUSS_KRUGER = 2, UTM = 3 };
+
+constexpr std::uint8_t magic[] = {'T', 'C', '1'};
+
+// Fixed-point values are kept below 2^62 in magnitude, so every delta
+// between two of them fits in an int64 other than INT64_MIN, whose zig-zag
+// code marks a missing (non-finite or out of range) value instead.
+constexpr double fixed_limit = 4611686018427387904.0;  // 2^62
+constexpr std::uint64_t missing = std::numeric_limits<std::uint64_t>::max();
+
+void put_varint(std::vector<std::uint8_t> &out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+class Reader {
+ public:
+    Reader(const std::uint8_t *begin, const std::uint8_t *end) : _p(begin), _end(end) {}
+
+    bool varint(std::uint64_t &value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && _p != _end; shift += 7) {
+            std::uint8_t byte = *_p++;
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+    bool byte(std::uint8_t &value) {
+        if (_p == _end) {
+            return false;
+        }
+        value = *_p++;
+        return true;
+    }
+    bool bytes(std::size_t n, const std::uint8_t *&begin) {
+        if (static_cast<std::size_t>(_end - _p) < n) {
+            return false;
+        }
+        begin = _p;
+        _p += n;
+        return true;
+    }
+
+ private:
+    const std::uint8_t *_p;
+    const std::uint8_t *_end;
+};
+
+class ColumnWriter {
+ public:
+    explicit ColumnWriter(double scale) : _scale(scale) {}
+
+    void put(double value) {
+        double scaled = value * _scale;
+        if (!(std::fabs(scaled) < fixed_limit)) {
+            put_varint(_bytes, missing);
+            return;
+        }
+        std::int64_t fixed = std::llround(scaled);
+        std::int64_t delta = fixed - _previous;
+        _previous = fixed;
+        put_varint(_bytes, (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63));
+    }
+    const std::vector<std::uint8_t> &bytes() const { return _bytes; }
+
+ private:
+    double _scale;
+    std::int64_t _previous{};
+    std::vector<std::uint8_t> _bytes;
+};
+
+class ColumnReader {
+ public:
+    ColumnReader(double scale, const std::uint8_t *begin, const std::uint8_t *end)
+        : _scale(scale), _reader(begin, end) {}
+
+    bool get(double &value) {
+        std::uint64_t zigzag = 0;
+        if (!_reader.varint(zigzag)) {
+            return false;
+        }
+        if (zigzag == missing) {
+            value = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
+        // Wrapping unsigned arithmetic: a crafted delta must not overflow.
+        std::uint64_t delta = (zigzag >> 1) ^ (0 - (zigzag & 1));
+        _previous += delta;
+        auto fixed = static_cast<std::int64_t>(_previous);
+        // The writer keeps values below 2^62; anything else is corrupt.
+        if (!(std::fabs(static_cast<double>(fixed)) < fixed_limit)) {
+            return false;
+        }
+        value = static_cast<double>(fixed) / _scale;
+        return true;
+    }
+
+ private:
+    double _scale;
+    Reader _reader;
+    std::uint64_t _previous{};
+};
+
+class ZoneWriter {
+ public:
+    void put(const std::string &zone) {
+        if (_run != 0 && zone == _zone) {
+            ++_run;
+            return;
+        }
+        flush();
+        _zone = zone;
+        _run = 1;
+    }
+    const std::vector<std::uint8_t> &bytes() {
+        flush();
+        return _bytes;
+    }
+
+ private:
+    void flush() {
+        if (_run == 0) {
+            return;
+        }
+        put_varint(_bytes, _run);
+        put_varint(_bytes, _zone.size());
+        _bytes.insert(_bytes.end(), _zone.begin(), _zone.end());
+        _run = 0;
+    }
+
+    std::string _zone;
+    std::uint64_t _run{};
+    std::vector<std::uint8_t> _bytes;
+};
+
+class ZoneReader {
+ public:
+    ZoneReader(const std::uint8_t *begin, const std::uint8_t *end) : _reader(begin, end) {}
+
+    bool get(std::string &zone) {
+        if (_run == 0) {
+            std::uint64_t size = 0;
+            const std::uint8_t *chars = nullptr;
+            if (!_reader.varint(_run) || _run == 0 || !_reader.varint(size) || !_reader.bytes(size, chars)) {
+                return false;
+            }
+            _zone.assign(chars, chars + size);
+        }
+        --_run;
+        zone = _zone;
+        return true;
+    }
+
+ private:
+    Reader _reader;
+    std::string _zone;
+    std::uint64_t _run{};
+};
+
+struct Column {
+    const std::uint8_t *begin;
+    const std::uint8_t *end;
+};
+
+std::vector<std::uint8_t> pack(KIND kind, std::size_t count, const std::vector<const std::vector<std::uint8_t> *> &columns) {
+    std::vector<std::uint8_t> out(magic, magic + sizeof(magic));
+    out.push_back(static_cast<std::uint8_t>(kind));
+    put_varint(out, count);
+    for (const std::vector<std::uint8_t> *column : columns) {
+        put_varint(out, column->size());
+        out.insert(out.end(), column->begin(), column->end());
+    }
+    return out;
+}
+
+// The first `numeric_count` columns hold one varint, at least one byte, per
+// point, which bounds `count` by the input size before anything is allocated.
+bool unpack(const std::vector<std::uint8_t> &bytes, KIND kind, std::size_t column_count, std::size_t numeric_count,
+            std::uint64_t &count, std::vector<Column> &columns) {
+    Reader reader(bytes.data(), bytes.data() + bytes.size());
+    const std::uint8_t *header = nullptr;
+    std::uint8_t stored_kind = 0;
+    if (!reader.bytes(sizeof(magic), header) || !std::equal(magic, magic + sizeof(magic), header) ||
+        !reader.byte(stored_kind) || stored_kind != static_cast<std::uint8_t>(kind) || !reader.varint(count)) {
+        return false;
+    }
+    columns.clear();
+    for (std::size_t i = 0; i < column_count; ++i) {
+        std::uint64_t size = 0;
+        const std::uint8_t *begin = nullptr;
+        if (!reader.varint(size) || !reader.bytes(size, begin)) {
+            return false;
+        }
+        if (i < numeric_count && size < count) {
+            return false;
+        }
+        columns.push_back(Column{begin, begin + size});
+    }
+    return true;
+}
+
+class WGS84Reader {
+ public:
+    bool open(const std::vector<std::uint8_t> &bytes) {
+        std::vector<Column> columns;
+        if (!unpack(bytes, KIND::WGS84, 3, 3, count, columns)) {
+            return false;
+        }
+        _latitude = ColumnReader(degree_scale, columns[0].begin, columns[0].end);
+        _longitude = ColumnReader(degree_scale, columns[1].begin, columns[1].end);
+        _altitude = ColumnReader(metre_scale, columns[2].begin, columns[2].end);
+        return true;
+    }
+    bool get(WGS84 &point) {
+        double latitude = 0;
+        double longitude = 0;
+        if (!_latitude.get(latitude) || !_longitude.get(longitude) || !_altitude.get(point.altitude)) {
+            return false;
+        }
+        point.latitude = Degree{latitude};
+        point.longitude = Degree{longitude};
+        return true;
+    }
+
+    std::uint64_t count{};
+
+ private:
+    ColumnReader _latitude{degree_scale, nullptr, nullptr};
+    ColumnReader _longitude{degree_scale, nullptr, nullptr};
+    ColumnReader _altitude{metre_scale, nullptr, nullptr};
+};
+
+class GaussKrugerWriter {
+ public:
+    void put(const GaussKruger &point) {
+        _x.put(point.x);
+        _y.put(point.y);
+        _height.put(point.height);
+        ++_count;
+    }
+    std::vector<std::uint8_t> finish() {
+        return pack(KIND::GAUSS_KRUGER, _count, {&_x.bytes(), &_y.bytes(), &_height.bytes()});
+    }
+
+ private:
+    ColumnWriter _x{metre_scale};
+    ColumnWriter _y{metre_scale};
+    ColumnWriter _height{metre_scale};
+    std::size_t _count{};
+};
+
+class UTMWriter {
+ public:
+    void put(const UTM &point) {
+        _E.put(point.E);
+        _N.put(point.N);
+        _altitude.put(point.altitude);
+        _zone.put(point.zone);
+        ++_count;
+    }
+    std::vector<std::uint8_t> finish() {
+        return pack(KIND::UTM, _count, {&_E.bytes(), &_N.bytes(), &_altitude.bytes(), &_zone.bytes()});
+    }
+
+ private:
+    ColumnWriter _E{metre_scale};
+    ColumnWriter _N{metre_scale};
+    ColumnWriter _altitude{metre_scale};
+    ZoneWriter _zone;
+    std::size_t _count{};
+};
+
+}  // namespace
+
+std::vector<std::uint8_t> encode(const std::vector<WGS84> &points) {
+    ColumnWriter latitude{degree_scale};
+    ColumnWriter longitude{degree_scale};
+    ColumnWriter altitude{metre_scale};
+    for (const WGS84 &point : points) {
+        latitude.put(point.latitude);
+        longitude.put(point.longitude);
+        altitude.put(point.altitude);
+    }
+    return pack(KIND::WGS84, points.size(), {&latitude.bytes(), &longitude.bytes(), &altitude.bytes()});
+}
+std::vector<std::uint8_t> encode(const std::vector<GaussKruger> &points) {
+    GaussKrugerWriter writer;
+    for (const GaussKruger &point : points) {
+        writer.put(point);
+    }
+    return writer.finish();
+}
+std::vector<std::uint8_t> encode(const std::vector<UTM> &points) {
+    UTMWriter writer;
+    for (const UTM &point : points) {
+        writer.put(point);
+    }
+    return writer.finish();
+}
+
+bool decode(const std::vector<std::uint8_t> &bytes, std::vector<WGS84> &points) {
+    WGS84Reader reader;
+    if (!reader.open(bytes)) {
+        return false;
+    }
+    points.assign(reader.count, WGS84{});
+    for (WGS84 &point : points) {
+        if (!reader.get(point)) {
+            return false;
+        }
+    }
+    return true;
+}
+bool decode(const std::vector<std::uint8_t> &bytes, std::vector<GaussKruger> &points) {
+    std::uint64_t count = 0;
+    std::vector<Column> columns;
+    if (!unpack(bytes, KIND::GAUSS_KRUGER, 3, 3, count, columns)) {
+        return false;
+    }
+    ColumnReader x(metre_scale, columns[0].begin, columns[0].end);
+    ColumnReader y(metre_scale, columns[1].begin, columns[1].end);
+    ColumnReader height(metre_scale, columns[2].begin, columns[2].end);
+    points.assign(count, GaussKruger{});
+    for (GaussKruger &point : points) {
+        if (!x.get(point.x) || !y.get(point.y) || !height.get(point.height)) {
+            return false;
+        }
+    }
+    return true;
+}
+bool decode(const std::vector<std::uint8_t> &bytes, std::vector<UTM> &points) {
+    std::uint64_t count = 0;
+    std::vector<Column> columns;
+    if (!unpack(bytes, KIND::UTM, 4, 3, count, columns)) {
+        return false;
+    }
+    ColumnReader E(metre_scale, columns[0].begin, columns[0].end);
+    ColumnReader N(metre_scale, columns[1].begin, columns[1].end);
+    ColumnReader altitude(metre_scale, columns[2].begin, columns[2].end);
+    ZoneReader zone(columns[3].begin, columns[3].end);
+    points.clear();
+    points.reserve(count);
+    for (std::uint64_t i = 0; i < count; ++i) {
+        double e = 0;
+        double n = 0;
+        double h = 0;
+        std::string z;
+        if (!E.get(e) || !N.get(n) || !altitude.get(h) || !zone.get(z)) {
+            return false;
+        }
+        points.push_back(UTM{Degree{e}, Degree{n}, h, z});
+    }
+    return true;
+}
+
+bool transcode_to_gauss_kruger(const std::vector<std::uint8_t> &wgs_84, std::vector<std::uint8_t> &gk) {
+    WGS84Reader reader;
+    if (!reader.open(wgs_84)) {
+        return false;
+    }
+    GaussKrugerWriter writer;
+    WGS84 point;
+    for (std::uint64_t i = 0; i < reader.count; ++i) {
+        if (!reader.get(point)) {
+            return false;
+        }
+        writer.put(GaussKruger{SK42{point}});
+    }
+    gk = writer.finish();
+    return true;
+}
+bool transcode_to_utm(const std::vector<std::uint8_t> &wgs_84, std::vector<std::uint8_t> &utm) {
+    WGS84Reader reader;
+    if (!reader.open(wgs_84)) {
+        return false;
+    }
+    UTMWriter writer;
+    WGS84 point;
+    for (std::uint64_t i = 0; i < reader.count; ++i) {
+        if (!reader.get(point)) {
+            return false;
+        }
+        writer.put(UTM{point});
+    }
+    utm = writer.finish();
+    return true;
+}
@@ -0,0 +1,28 @@
+#ifndef TRANSFORMATION_LIB_CODEC_H_
+#define TRANSFORMATION_LIB_CODEC_H_
+
+#include "transformations.h"
+
+#include <cstdint>
+#include <vector>
+
+// Compact columnar encoding of coordinate streams. Values are stored as
+// fixed-point integers (1 mm for metres, 1e-8 degree for angles), every
+// column is delta + zig-zag varint encoded and UTM zones are run-length
+// encoded. Non-finite values, and values too large for the fixed-point
+// range, are stored as missing and decode as NaN. decode() returns false on
+// truncated or foreign input without allocating more than the input implies.
+std::vector<std::uint8_t> encode(const std::vector<WGS84> &points);
+std::vector<std::uint8_t> encode(const std::vector<GaussKruger> &points);
+std::vector<std::uint8_t> encode(const std::vector<UTM> &points);
+
+bool decode(const std::vector<std::uint8_t> &bytes, std::vector<WGS84> &points);
+bool decode(const std::vector<std::uint8_t> &bytes, std::vector<GaussKruger> &points);
+bool decode(const std::vector<std::uint8_t> &bytes, std::vector<UTM> &points);
+
+// Converts an encoded WGS84 stream point by point straight into an encoded
+// projected stream, without building intermediate arrays of doubles.
+bool transcode_to_gauss_kruger(const std::vector<std::uint8_t> &wgs_84, std::vector<std::uint8_t> &gk);
+bool transcode_to_utm(const std::vector<std::uint8_t> &wgs_84, std::vector<std::uint8_t> &utm);
+
+#endif  // TRANSFORMATION_LIB_CODEC_H_
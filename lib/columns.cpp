@@ -0,0 +1,110 @@
+#include "columns.h"
+
+#include "stats.h"
+#include "transformations.h"
+
+namespace {
+
+double row(const DoubleColumn &column, std::size_t i) {
+    return column.values[column.offset + i];
+}
+
+// Validity bits of rows 8 * i to 8 * i + 7 of `column`, realigned from its
+// offset; a missing bitmap means "all valid" and reads as 0xff.
+std::uint8_t validity_byte(const DoubleColumn &column, std::size_t length, std::size_t i) {
+    if (!column.validity) {
+        return 0xff;
+    }
+    std::size_t bit = column.offset + 8 * i;
+    std::size_t byte = bit / 8;
+    unsigned shift = bit % 8;
+    if (shift == 0) {
+        return column.validity[byte];
+    }
+    unsigned bits = column.validity[byte] >> shift;
+    // The next byte may lie past the end of the bitmap when it holds no rows.
+    if ((byte + 1) * 8 < column.offset + length) {
+        bits |= static_cast<unsigned>(column.validity[byte + 1]) << (8 - shift);
+    }
+    return static_cast<std::uint8_t>(bits);
+}
+
+// Combines the input bitmaps a byte at a time.
+void combine_validity(std::size_t length, const DoubleColumn &a, const DoubleColumn &b, const DoubleColumn &c,
+                      std::uint8_t *const *outputs, std::size_t output_count) {
+    std::size_t bytes = (length + 7) / 8;
+    for (std::size_t i = 0; i < bytes; ++i) {
+        std::uint8_t valid = validity_byte(a, length, i) & validity_byte(b, length, i) &
+                             validity_byte(c, length, i);
+        for (std::size_t o = 0; o < output_count; ++o) {
+            if (outputs[o]) {
+                outputs[o][i] = valid;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+void to_gauss_kruger(std::size_t length,
+                     DoubleColumn latitude, DoubleColumn longitude, DoubleColumn altitude,
+                     MutableDoubleColumn x, MutableDoubleColumn y, MutableDoubleColumn height) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_GAUSS_KRUGER, length);
+    for (std::size_t i = 0; i < length; ++i) {
+        GaussKruger gk{SK42{WGS84{Degree{row(latitude, i)}, Degree{row(longitude, i)}, row(altitude, i)}}};
+        x.values[i] = gk.x;
+        y.values[i] = gk.y;
+        height.values[i] = gk.height;
+    }
+    std::uint8_t *outputs[] = {x.validity, y.validity, height.validity};
+    combine_validity(length, latitude, longitude, altitude, outputs, 3);
+}
+
+void to_wgs84(std::size_t length,
+              DoubleColumn x, DoubleColumn y, DoubleColumn height,
+              MutableDoubleColumn latitude, MutableDoubleColumn longitude, MutableDoubleColumn altitude) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_WGS84, length);
+    for (std::size_t i = 0; i < length; ++i) {
+        GaussKruger gk;
+        gk.x = row(x, i);
+        gk.y = row(y, i);
+        gk.height = row(height, i);
+        WGS84 wgs_84{SK42{gk}};
+        latitude.values[i] = wgs_84.latitude;
+        longitude.values[i] = wgs_84.longitude;
+        altitude.values[i] = wgs_84.altitude;
+    }
+    std::uint8_t *outputs[] = {latitude.validity, longitude.validity, altitude.validity};
+    combine_validity(length, x, y, height, outputs, 3);
+}
+
+void to_utm(std::size_t length,
+            DoubleColumn latitude, DoubleColumn longitude, DoubleColumn altitude,
+            MutableDoubleColumn E, MutableDoubleColumn N, MutableDoubleColumn utm_altitude,
+            std::int32_t *zone_number, char *zone_letter) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_UTM, length);
+    for (std::size_t i = 0; i < length; ++i) {
+        int number = 0;
+        UTM::project(WGS84{Degree{row(latitude, i)}, Degree{row(longitude, i)}, row(altitude, i)}, E.values[i],
+                     N.values[i], number, zone_letter[i]);
+        utm_altitude.values[i] = row(altitude, i);
+        zone_number[i] = number;
+    }
+    std::uint8_t *outputs[] = {E.validity, N.validity, utm_altitude.validity};
+    combine_validity(length, latitude, longitude, altitude, outputs, 3);
+}
+
+void to_wgs84(std::size_t length,
+              DoubleColumn E, DoubleColumn N, DoubleColumn utm_altitude,
+              const std::int32_t *zone_number, const char *zone_letter,
+              MutableDoubleColumn latitude, MutableDoubleColumn longitude, MutableDoubleColumn altitude) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_WGS84, length);
+    for (std::size_t i = 0; i < length; ++i) {
+        WGS84 wgs_84 = UTM::unproject(row(E, i), row(N, i), row(utm_altitude, i), zone_number[i], zone_letter[i]);
+        latitude.values[i] = wgs_84.latitude;
+        longitude.values[i] = wgs_84.longitude;
+        altitude.values[i] = wgs_84.altitude;
+    }
+    std::uint8_t *outputs[] = {latitude.validity, longitude.validity, altitude.validity};
+    combine_validity(length, E, N, utm_altitude, outputs, 3);
+}
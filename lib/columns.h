@@ -0,0 +1,44 @@
+#ifndef TRANSFORMATION_LIB_COLUMNS_H_
+#define TRANSFORMATION_LIB_COLUMNS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// A column of doubles laid out like an Arrow Float64Array: `values` holds the
+// rows and `validity` is an LSB-first bitmap with one bit per row, or nullptr
+// when every row is valid. Row i is values[offset + i] with validity bit
+// offset + i, so slices of an array are read without copying. Columns are read
+// and written in place; outputs always start at row 0.
+struct DoubleColumn {
+    const double *values;
+    const std::uint8_t *validity;
+    std::size_t offset;
+};
+
+struct MutableDoubleColumn {
+    double *values;
+    std::uint8_t *validity;
+};
+
+// Columnar versions of the batch routes. Every row is converted regardless of
+// its validity; the output bitmap (if not nullptr) is the AND of the input
+// bitmaps, so nulls propagate without a branch per value. Output buffers must
+// hold `length` values and (length + 7) / 8 bitmap bytes.
+void to_gauss_kruger(std::size_t length,
+                     DoubleColumn latitude, DoubleColumn longitude, DoubleColumn altitude,
+                     MutableDoubleColumn x, MutableDoubleColumn y, MutableDoubleColumn height);
+void to_wgs84(std::size_t length,
+              DoubleColumn x, DoubleColumn y, DoubleColumn height,
+              MutableDoubleColumn latitude, MutableDoubleColumn longitude, MutableDoubleColumn altitude);
+
+// UTM zones are split into the zone number and the latitude band letter.
+void to_utm(std::size_t length,
+            DoubleColumn latitude, DoubleColumn longitude, DoubleColumn altitude,
+            MutableDoubleColumn E, MutableDoubleColumn N, MutableDoubleColumn utm_altitude,
+            std::int32_t *zone_number, char *zone_letter);
+void to_wgs84(std::size_t length,
+              DoubleColumn E, DoubleColumn N, DoubleColumn utm_altitude,
+              const std::int32_t *zone_number, const char *zone_letter,
+              MutableDoubleColumn latitude, MutableDoubleColumn longitude, MutableDoubleColumn altitude);
+
+#endif  // TRANSFORMATION_LIB_COLUMNS_H_
@@ -0,0 +1,161 @@
+#ifndef TRANSFORMATION_LIB_CONVERSION_CACHE_H_
+#define TRANSFORMATION_LIB_CONVERSION_CACHE_H_
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Memoizes one conversion route, e.g.
+//     ConversionCache<WGS84, GaussKruger> cache(
+//         [](const WGS84 &p) { return GaussKruger{SK42{p}}; }, 100000);
+// Inputs are geodetic points (WGS84, PZ90) keyed on latitude/longitude
+// quantized to `angle_quantum` degrees and altitude to `height_quantum`
+// metres, so points that differ by less than that share a result. The cache
+// is split into shards with their own lock and LRU list; each shard holds at
+// most capacity / shards entries. Points with a NaN, infinite or quantized
+// value beyond the range of long long are converted without being cached,
+// and count as misses.
+template <class In, class Out>
+class ConversionCache {
+ public:
+    using Convert = std::function<Out(const In &)>;
+
+    struct Metrics {
+        std::uint64_t hits;
+        std::uint64_t misses;
+        std::uint64_t evictions;
+
+        double hit_rate() const {
+            return hits + misses == 0 ? 0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+        }
+    };
+
+    ConversionCache(Convert convert, std::size_t capacity, std::size_t shards = 16,
+                    double angle_quantum = 1e-9, double height_quantum = 1e-3)
+        : _convert(std::move(convert)),
+          _shards(shards == 0 ? 1 : shards),
+          _angle_scale(1 / angle_quantum),
+          _height_scale(1 / height_quantum) {
+        _shard_capacity = capacity / _shards.size();
+        if (_shard_capacity == 0) {
+            _shard_capacity = 1;
+        }
+    }
+
+    Out operator()(const In &point) {
+        Key key;
+        if (!quantize(point.latitude * _angle_scale, key.latitude) ||
+            !quantize(point.longitude * _angle_scale, key.longitude) ||
+            !quantize(point.altitude * _height_scale, key.altitude)) {
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return _convert(point);
+        }
+        std::size_t hash = KeyHash()(key);
+        Shard &shard = _shards[hash % _shards.size()];
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto found = shard.index.find(key);
+            if (found != shard.index.end()) {
+                shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+                _hits.fetch_add(1, std::memory_order_relaxed);
+                return found->second->second;
+            }
+        }
+        // Convert outside the lock; a concurrent miss on the same key just
+        // converts twice.
+        Out result = _convert(point);
+        _misses.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (shard.index.find(key) == shard.index.end()) {
+            shard.entries.emplace_front(key, result);
+            shard.index.emplace(key, shard.entries.begin());
+            if (shard.entries.size() > _shard_capacity) {
+                shard.index.erase(shard.entries.back().first);
+                shard.entries.pop_back();
+                _evictions.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
+    std::vector<Out> operator()(const std::vector<In> &points) {
+        std::vector<Out> result;
+        result.reserve(points.size());
+        for (const In &point : points) {
+            result.push_back((*this)(point));
+        }
+        return result;
+    }
+
+    Metrics metrics() const {
+        return Metrics{_hits.load(std::memory_order_relaxed),
+                       _misses.load(std::memory_order_relaxed),
+                       _evictions.load(std::memory_order_relaxed)};
+    }
+
+    void clear() {
+        for (Shard &shard : _shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.index.clear();
+            shard.entries.clear();
+        }
+        _hits = 0;
+        _misses = 0;
+        _evictions = 0;
+    }
+
+ private:
+    struct Key {
+        long long latitude;
+        long long longitude;
+        long long altitude;
+
+        bool operator==(const Key &other) const {
+            return latitude == other.latitude && longitude == other.longitude && altitude == other.altitude;
+        }
+    };
+
+    // llround() is undefined for NaN and for results outside long long.
+    static bool quantize(double scaled, long long &quantized) {
+        if (!(std::fabs(scaled) < 9.2e18)) {
+            return false;
+        }
+        quantized = std::llround(scaled);
+        return true;
+    }
+
+    struct KeyHash {
+        std::size_t operator()(const Key &key) const {
+            std::uint64_t h = static_cast<std::uint64_t>(key.latitude) * 0x9e3779b97f4a7c15ull;
+            h ^= static_cast<std::uint64_t>(key.longitude) + 0x7f4a7c159e3779b9ull + (h << 6) + (h >> 2);
+            h ^= static_cast<std::uint64_t>(key.altitude) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            return static_cast<std::size_t>(h ^ (h >> 32));
+        }
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::list<std::pair<Key, Out>> entries;  // most recently used first
+        std::unordered_map<Key, typename std::list<std::pair<Key, Out>>::iterator, KeyHash> index;
+    };
+
+    Convert _convert;
+    std::vector<Shard> _shards;
+    std::size_t _shard_capacity;
+    double _angle_scale;
+    double _height_scale;
+    std::atomic<std::uint64_t> _hits{};
+    std::atomic<std::uint64_t> _misses{};
+    std::atomic<std::uint64_t> _evictions{};
+};
+
+#endif  // TRANSFORMATION_LIB_CONVERSION_CACHE_H_
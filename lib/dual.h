@@ -0,0 +1,112 @@
+#ifndef TRANSFORMATION_LIB_DUAL_H_
+#define TRANSFORMATION_LIB_DUAL_H_
+
+#include <cstddef>
+
+// Forward-mode dual number: a value and its partial derivatives with respect
+// to N independent variables. Series code templated on its scalar type
+// yields the derivatives alongside the value in the same pass. Elementary
+// functions are provided by the code that uses it, through apply().
+template <std::size_t N>
+struct Dual {
+    double value;
+    double d[N];
+
+    // The i-th independent variable.
+    static Dual variable(double value, std::size_t i) {
+        Dual x{};
+        x.value = value;
+        x.d[i] = 1;
+        return x;
+    }
+    // f(x), given f and its derivative at value.
+    Dual apply(double f, double df) const {
+        Dual result;
+        result.value = f;
+        for (std::size_t i = 0; i < N; ++i) {
+            result.d[i] = df * d[i];
+        }
+        return result;
+    }
+};
+
+template <std::size_t N>
+Dual<N> operator-(const Dual<N> &a) {
+    return a.apply(-a.value, -1);
+}
+
+template <std::size_t N>
+Dual<N> operator+(const Dual<N> &a, const Dual<N> &b) {
+    Dual<N> result;
+    result.value = a.value + b.value;
+    for (std::size_t i = 0; i < N; ++i) {
+        result.d[i] = a.d[i] + b.d[i];
+    }
+    return result;
+}
+template <std::size_t N>
+Dual<N> operator+(const Dual<N> &a, double b) {
+    Dual<N> result = a;
+    result.value = a.value + b;
+    return result;
+}
+template <std::size_t N>
+Dual<N> operator+(double a, const Dual<N> &b) {
+    Dual<N> result = b;
+    result.value = a + b.value;
+    return result;
+}
+
+template <std::size_t N>
+Dual<N> operator-(const Dual<N> &a, const Dual<N> &b) {
+    Dual<N> result;
+    result.value = a.value - b.value;
+    for (std::size_t i = 0; i < N; ++i) {
+        result.d[i] = a.d[i] - b.d[i];
+    }
+    return result;
+}
+template <std::size_t N>
+Dual<N> operator-(const Dual<N> &a, double b) {
+    Dual<N> result = a;
+    result.value = a.value - b;
+    return result;
+}
+template <std::size_t N>
+Dual<N> operator-(double a, const Dual<N> &b) {
+    return b.apply(a - b.value, -1);
+}
+
+template <std::size_t N>
+Dual<N> operator*(const Dual<N> &a, const Dual<N> &b) {
+    Dual<N> result;
+    result.value = a.value * b.value;
+    for (std::size_t i = 0; i < N; ++i) {
+        result.d[i] = a.d[i] * b.value + a.value * b.d[i];
+    }
+    return result;
+}
+template <std::size_t N>
+Dual<N> operator*(const Dual<N> &a, double b) {
+    return a.apply(a.value * b, b);
+}
+template <std::size_t N>
+Dual<N> operator*(double a, const Dual<N> &b) {
+    return b.apply(a * b.value, a);
+}
+
+template <std::size_t N>
+Dual<N> operator/(const Dual<N> &a, const Dual<N> &b) {
+    Dual<N> result;
+    result.value = a.value / b.value;
+    for (std::size_t i = 0; i < N; ++i) {
+        result.d[i] = (a.d[i] - result.value * b.d[i]) / b.value;
+    }
+    return result;
+}
+template <std::size_t N>
+Dual<N> operator/(const Dual<N> &a, double b) {
+    return a.apply(a.value / b, 1 / b);
+}
+
+#endif  // TRANSFORMATION_LIB_DUAL_H_
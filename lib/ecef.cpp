@@ -0,0 +1,102 @@
+#include "ecef.h"
+
+#include "elementary.h"
+#include "ellipsoid.h"
+#include "stats.h"
+
+#include <cmath>
+
+ECEF to_ecef(Degree latitude, Degree longitude, double height, ELLIPSOID which) {
+    TRANSFORMATIONS_COUNTED(ROUTE::ECEF_FROM_GEODETIC);
+    Ellipsoid e = ellipsoid(which);
+    double e2 = e.e2();
+    Radian B = latitude;
+    Radian L = longitude;
+    double sinB = math::sin(B);
+    double cosB = math::cos(B);
+    double N = e.a / math::sqrt(1 - e2 * sinB * sinB);
+    return ECEF{(N + height) * cosB * math::cos(L), (N + height) * cosB * math::sin(L), (N * (1 - e2) + height) * sinB};
+}
+
+void to_geodetic(const ECEF &ecef, ELLIPSOID which, Degree &latitude, Degree &longitude, double &height) {
+    TRANSFORMATIONS_COUNTED(ROUTE::GEODETIC_FROM_ECEF);
+    Ellipsoid e = ellipsoid(which);
+    double e2 = e.e2();
+    double e4 = e2 * e2;
+    double rho2 = ecef.x * ecef.x + ecef.y * ecef.y;
+    double rho = math::sqrt(rho2);
+
+    double p = rho2 / (e.a * e.a);
+    double q = (1 - e2) * ecef.z * ecef.z / (e.a * e.a);
+    double r = (p + q - e4) / 6;
+    double s = e4 * p * q / (4 * r * r * r);
+    double t = math::cbrt(1 + s + math::sqrt(s * (2 + s)));
+    double u = r * (1 + t + 1 / t);
+    double v = math::sqrt(u * u + e4 * q);
+    double w = e2 * (u + v - q) / (2 * v);
+    double k = math::sqrt(u + v + w * w) - w;
+    double D = k * rho / (k + e2);
+    double distance = math::sqrt(D * D + ecef.z * ecef.z);
+
+    latitude = Radian{2 * math::atan2(ecef.z, D + distance)};
+    longitude = Radian{math::atan2(ecef.y, ecef.x)};
+    height = (k + e2 - 1) / k * distance;
+}
+
+void to_ecef(const double *latitude, const double *longitude, const double *height,
+             double *x, double *y, double *z, std::size_t n, ELLIPSOID which) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_ECEF, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ECEF ecef = to_ecef(Degree{latitude[i]}, Degree{longitude[i]}, height[i], which);
+        x[i] = ecef.x;
+        y[i] = ecef.y;
+        z[i] = ecef.z;
+    }
+}
+
+void to_geodetic(const double *x, const double *y, const double *z,
+                 double *latitude, double *longitude, double *height, std::size_t n, ELLIPSOID which) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_FROM_ECEF, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        Degree B, L;
+        double H;
+        to_geodetic(ECEF{x[i], y[i], z[i]}, which, B, L, H);
+        latitude[i] = B;
+        longitude[i] = L;
+        height[i] = H;
+    }
+}
+
+std::vector<ECEF> to_ecef(const std::vector<WGS84> &wgs_84) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_TO_ECEF, wgs_84.size());
+    std::vector<ECEF> result;
+    result.reserve(wgs_84.size());
+    for (const WGS84 &point : wgs_84) {
+        result.emplace_back(point);
+    }
+    return result;
+}
+
+std::vector<WGS84> to_wgs84(const std::vector<ECEF> &ecef) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_FROM_ECEF, ecef.size());
+    std::vector<WGS84> result;
+    result.reserve(ecef.size());
+    for (const ECEF &point : ecef) {
+        result.emplace_back(point);
+    }
+    return result;
+}
+
+ECEF::ECEF(WGS84 wgs_84) : ECEF(to_ecef(wgs_84.latitude, wgs_84.longitude, wgs_84.altitude, ELLIPSOID::WGS84)) {}
+ECEF::ECEF(PZ90 pz_90) : ECEF(to_ecef(pz_90.latitude, pz_90.longitude, pz_90.altitude, ELLIPSOID::PZ90)) {}
+ECEF::ECEF(SK42 sk_42) : ECEF(to_ecef(sk_42.latitude, sk_42.longitude, sk_42.altitude, ELLIPSOID::SK42)) {}
+
+WGS84::WGS84(ECEF ecef) {
+    to_geodetic(ecef, ELLIPSOID::WGS84, latitude, longitude, altitude);
+}
+PZ90::PZ90(ECEF ecef) {
+    to_geodetic(ecef, ELLIPSOID::PZ90, latitude, longitude, altitude);
+}
+SK42::SK42(ECEF ecef) {
+    to_geodetic(ecef, ELLIPSOID::SK42, latitude, longitude, altitude);
+}
@@ -0,0 +1,39 @@
+#ifndef TRANSFORMATION_LIB_ECEF_H_
+#define TRANSFORMATION_LIB_ECEF_H_
+
+#include "transformations.h"
+
+#include <cstddef>
+#include <vector>
+
+// Earth-centred, Earth-fixed Cartesian coordinates in metres, in the frame
+// of the datum the point came from: ECEF(SK42) and ECEF(WGS84) of the same
+// place differ by the datum shift. Moving between frames is a Helmert
+// transformation (see helmert.h).
+class ECEF {
+ public:
+    ECEF() = default;
+    ECEF(double x, double y, double z) : x(x), y(y), z(z) {}
+    explicit ECEF(WGS84 wgs_84);
+    explicit ECEF(PZ90 pz_90);
+    explicit ECEF(SK42 sk_42);
+    double x{};
+    double y{};
+    double z{};
+};
+
+ECEF to_ecef(Degree latitude, Degree longitude, double height, ELLIPSOID which);
+// Closed form (Vermeille, 2011), no iteration. Exact for every point farther
+// than a few tens of kilometres from the Earth's centre.
+void to_geodetic(const ECEF &ecef, ELLIPSOID which, Degree &latitude, Degree &longitude, double &height);
+
+// Array versions on separate columns; outputs may alias the inputs.
+void to_ecef(const double *latitude, const double *longitude, const double *height,
+             double *x, double *y, double *z, std::size_t n, ELLIPSOID which);
+void to_geodetic(const double *x, const double *y, const double *z,
+                 double *latitude, double *longitude, double *height, std::size_t n, ELLIPSOID which);
+
+std::vector<ECEF> to_ecef(const std::vector<WGS84> &wgs_84);
+std::vector<WGS84> to_wgs84(const std::vector<ECEF> &ecef);
+
+#endif  // TRANSFORMATION_LIB_ECEF_H_
@@ -0,0 +1,41 @@
+#ifndef TRANSFORMATION_LIB_ELEMENTARY_H_
+#define TRANSFORMATION_LIB_ELEMENTARY_H_
+
+#include "fixed_math.h"
+
+#include <cmath>
+
+// Elementary functions for the library's own sources: libm, or fixed_math
+// when TRANSFORMATIONS_DETERMINISTIC is defined, so that every conversion
+// switches together. Functions IEEE 754 rounds exactly (sqrt, floor, fmod,
+// remainder, ...) are used from <cmath> directly.
+namespace math {
+
+#ifdef TRANSFORMATIONS_DETERMINISTIC
+using fixed_math::sin;
+using fixed_math::cos;
+using fixed_math::tan;
+using fixed_math::atan;
+using fixed_math::atan2;
+using fixed_math::asin;
+using fixed_math::pow;
+using fixed_math::cbrt;
+using fixed_math::log;
+using fixed_math::hypot;
+#else
+using std::sin;
+using std::cos;
+using std::tan;
+using std::atan;
+using std::atan2;
+using std::asin;
+using std::pow;
+using std::cbrt;
+using std::log;
+using std::hypot;
+#endif
+using std::sqrt;
+
+}  // namespace math
+
+#endif  // TRANSFORMATION_LIB_ELEMENTARY_H_
@@ -0,0 +1,23 @@
+#ifndef TRANSFORMATION_LIB_ELLIPSOID_H_
+#define TRANSFORMATION_LIB_ELLIPSOID_H_
+
+#include "transformations.h"
+
+// Defining constants of the supported ellipsoids. The datum classes keep the
+// constants their Molodensky parameters were derived with (see WGS84::_a);
+// everything that works on the ellipsoid itself uses this table.
+struct Ellipsoid {
+    double a;
+    double f;
+
+    constexpr double b() const { return a * (1 - f); }
+    constexpr double e2() const { return f * (2 - f); }
+};
+
+constexpr Ellipsoid ellipsoid(ELLIPSOID which) {
+    return which == ELLIPSOID::PZ90 ? Ellipsoid{6378136.5, 1 / 298.25784}
+         : which == ELLIPSOID::SK42 ? Ellipsoid{6378245, 1 / 298.3}
+         : Ellipsoid{6378137, 1 / 298.257223563};
+}
+
+#endif  // TRANSFORMATION_LIB_ELLIPSOID_H_
@@ -0,0 +1,283 @@
+#include "fixed_math.h"
+
+#include <cmath>
+
+namespace {
+
+// Split of pi/2 for Cody-Waite reduction and the sine and cosine kernels on
+// [-pi/4, pi/4], all from fdlibm.
+constexpr double invpio2 = 6.36619772367581382433e-01;
+constexpr double pio2_1 = 1.57079632673412561417e+00;
+constexpr double pio2_2 = 6.07710050630396597660e-11;
+constexpr double pio2_2t = 2.02226624879595063154e-21;
+constexpr double pio2_3 = 2.02226624871116645580e-21;
+constexpr double pio2_3t = 8.47842766036889956997e-32;
+
+constexpr double S1 = -1.66666666666666324348e-01;
+constexpr double S2 = 8.33333333332248946124e-03;
+constexpr double S3 = -1.98412698298579493134e-04;
+constexpr double S4 = 2.75573137070700676789e-06;
+constexpr double S5 = -2.50507602534068634195e-08;
+constexpr double S6 = 1.58969099521155010221e-10;
+
+constexpr double C1 = 4.16666666666666019037e-02;
+constexpr double C2 = -1.38888888888741095749e-03;
+constexpr double C3 = 2.48015872894767294178e-05;
+constexpr double C4 = -2.75573143513906633035e-07;
+constexpr double C5 = 2.08757232129817482790e-09;
+constexpr double C6 = -1.13596475577881948265e-11;
+
+// x - n * pi/2 as the unevaluated sum y0 + y1, |y0| <= pi/4; returns n mod 4.
+int reduce(double x, double &y0, double &y1) {
+    if (!std::isfinite(x)) {
+        y0 = y1 = x - x;
+        return 0;
+    }
+    double n = std::floor(x * invpio2 + 0.5);
+    double r = x - n * pio2_1;
+    double t = r;
+    double w = n * pio2_2;
+    r = t - w;
+    w = n * pio2_2t - ((t - r) - w);
+    t = r;
+    w = n * pio2_3;
+    r = t - w;
+    w = n * pio2_3t - ((t - r) - w);
+    y0 = r - w;
+    y1 = (r - y0) - w;
+    return static_cast<int>(n - 4 * std::floor(n / 4));
+}
+
+double kernel_sin(double x, double y) {
+    double z = x * x;
+    double v = z * x;
+    double r = S2 + z * (S3 + z * (S4 + z * (S5 + z * S6)));
+    return x - ((z * (0.5 * y - v * r) - y) - v * S1);
+}
+
+double kernel_cos(double x, double y) {
+    double z = x * x;
+    double w = z * z;
+    double r = z * (C1 + z * (C2 + z * C3)) + w * w * (C4 + z * (C5 + z * C6));
+    double hz = 0.5 * z;
+    w = 1 - hz;
+    return w + (((1 - w) - hz) + (z * r - x * y));
+}
+
+// atan on [0, 7/16] and the breakpoints 0.5, 1, 1.5 and infinity it is
+// shifted from, split into high and low parts; from fdlibm.
+constexpr double atanhi[] = {4.63647609000806093515e-01, 7.85398163397448278999e-01,
+                             9.82793723247329054082e-01, 1.57079632679489655800e+00};
+constexpr double atanlo[] = {2.26987774529616870924e-17, 3.06161699786838301793e-17,
+                             1.39033110312309984516e-17, 6.12323399573676603587e-17};
+constexpr double aT[] = {3.33333333333329318027e-01, -1.99999999998764832476e-01, 1.42857142725034663711e-01,
+                         -1.11111104054623557880e-01, 9.09088713343650656196e-02, -7.69187620504482999495e-02,
+                         6.66107313738753120669e-02, -5.83357013379057348645e-02, 4.97687799461593236017e-02,
+                         -3.65315727442169155270e-02, 1.62858201153657823623e-02};
+
+constexpr double pi = 3.1415926535897931160e+00;
+constexpr double pi_lo = 1.2246467991473531772e-16;
+
+// log(1 + f) for sqrt(2)/2 - 1 < f < sqrt(2) - 1, from fdlibm.
+constexpr double ln2_hi = 6.93147180369123816490e-01;
+constexpr double ln2_lo = 1.90821492927058770002e-10;
+constexpr double Lg1 = 6.666666666666735130e-01;
+constexpr double Lg2 = 3.999999999940941908e-01;
+constexpr double Lg3 = 2.857142874366239149e-01;
+constexpr double Lg4 = 2.222219843214978396e-01;
+constexpr double Lg5 = 1.818357216161805012e-01;
+constexpr double Lg6 = 1.531383769920937332e-01;
+constexpr double Lg7 = 1.479819860511658591e-01;
+
+double integer_pow(double x, long n) {
+    bool negative = n < 0;
+    unsigned long m = negative ? -static_cast<unsigned long>(n) : static_cast<unsigned long>(n);
+    double result = 1;
+    for (double base = x; m != 0; m >>= 1, base *= base) {
+        if (m & 1) {
+            result *= base;
+        }
+    }
+    return negative ? 1 / result : result;
+}
+
+}  // namespace
+
+namespace fixed_math {
+
+double sin(double x) {
+    double y0, y1;
+    switch (reduce(x, y0, y1)) {
+        case 0: return kernel_sin(y0, y1);
+        case 1: return kernel_cos(y0, y1);
+        case 2: return -kernel_sin(y0, y1);
+        default: return -kernel_cos(y0, y1);
+    }
+}
+
+double cos(double x) {
+    double y0, y1;
+    switch (reduce(x, y0, y1)) {
+        case 0: return kernel_cos(y0, y1);
+        case 1: return -kernel_sin(y0, y1);
+        case 2: return -kernel_cos(y0, y1);
+        default: return kernel_sin(y0, y1);
+    }
+}
+
+double tan(double x) {
+    double y0, y1;
+    int quadrant = reduce(x, y0, y1);
+    double s = kernel_sin(y0, y1);
+    double c = kernel_cos(y0, y1);
+    return quadrant % 2 == 0 ? s / c : -c / s;
+}
+
+double pow(double x, double y) {
+    double twice = 2 * y;
+    if (y == std::floor(y) && std::fabs(y) < 1 << 30) {
+        return integer_pow(x, static_cast<long>(y));
+    }
+    if (twice == std::floor(twice) && std::fabs(twice) < 1 << 30) {
+        return integer_pow(x, static_cast<long>(std::floor(y))) * std::sqrt(x);
+    }
+    return std::pow(x, y);
+}
+
+double sqrt(double x) {
+    return std::sqrt(x);
+}
+
+double atan(double x) {
+    double a = std::fabs(x);
+    if (std::isnan(x)) {
+        return x + x;
+    }
+    if (a >= 7.378697629483820646e+19) {  // 2^66
+        return std::copysign(atanhi[3] + atanlo[3], x);
+    }
+    int id;
+    double t;
+    if (a < 0.4375) {
+        if (a < 1.862645149230957031e-09) {  // 2^-29
+            return x;
+        }
+        id = -1;
+        t = x;
+    } else if (a < 0.6875) {
+        id = 0;
+        t = (2 * a - 1) / (2 + a);
+    } else if (a < 1.1875) {
+        id = 1;
+        t = (a - 1) / (a + 1);
+    } else if (a < 2.4375) {
+        id = 2;
+        t = (a - 1.5) / (1 + 1.5 * a);
+    } else {
+        id = 3;
+        t = -1 / a;
+    }
+    double z = t * t;
+    double w = z * z;
+    double s1 = z * (aT[0] + w * (aT[2] + w * (aT[4] + w * (aT[6] + w * (aT[8] + w * aT[10])))));
+    double s2 = w * (aT[1] + w * (aT[3] + w * (aT[5] + w * (aT[7] + w * aT[9]))));
+    if (id < 0) {
+        return t - t * (s1 + s2);
+    }
+    z = atanhi[id] - ((t * (s1 + s2) - atanlo[id]) - t);
+    return std::copysign(z, x);
+}
+
+double atan2(double y, double x) {
+    if (std::isnan(x) || std::isnan(y)) {
+        return x + y;
+    }
+    if (x == 1) {
+        return atan(y);
+    }
+    bool negative_y = std::signbit(y);
+    bool negative_x = std::signbit(x);
+    if (y == 0) {
+        return negative_x ? std::copysign(pi, y) : y;
+    }
+    if (x == 0 || (std::isinf(y) && !std::isinf(x))) {
+        return std::copysign(atanhi[3] + atanlo[3], y);
+    }
+    if (std::isinf(x)) {
+        double z = std::isinf(y) ? (negative_x ? 3 * atanhi[1] : atanhi[1]) : (negative_x ? pi : 0.0);
+        return negative_y ? -z : z;
+    }
+    // Exponent difference, exact for every finite non-zero pair.
+    int k = std::ilogb(y) - std::ilogb(x);
+    double z;
+    if (k > 60) {
+        z = atanhi[3] + 0.5 * pi_lo;
+        negative_x = false;
+    } else if (negative_x && k < -60) {
+        z = 0;
+    } else {
+        z = atan(std::fabs(y / x));
+    }
+    if (negative_x) {
+        z = pi - (z - pi_lo);
+    }
+    return negative_y ? -z : z;
+}
+
+double asin(double x) {
+    return atan2(x, std::sqrt((1 - x) * (1 + x)));
+}
+
+double cbrt(double x) {
+    if (x == 0 || !std::isfinite(x)) {
+        return x;
+    }
+    // |x| = m 2^(3q) with m in [0.5, 4). Newton steps from a linear guess
+    // reach about 30 bits; rounding that to float makes t * t exact, so the
+    // final Halley step (as in fdlibm) loses almost nothing to rounding.
+    int e;
+    double m = std::frexp(std::fabs(x), &e);
+    int r = ((e % 3) + 3) % 3;
+    m = std::ldexp(m, r);
+    double t = 0.6 + 0.25 * m;
+    for (int i = 0; i < 4; ++i) {
+        t -= (t - m / (t * t)) / 3;
+    }
+    t = static_cast<float>(t);
+    double q = m / (t * t);
+    t += t * ((q - t) / (t + t + q));
+    return std::copysign(std::ldexp(t, (e - r) / 3), x);
+}
+
+double log(double x) {
+    if (std::isnan(x) || x < 0) {
+        return (x - x) / (x - x);
+    }
+    if (x == 0) {
+        return -1 / (x * x);
+    }
+    if (std::isinf(x)) {
+        return x;
+    }
+    // x = 2^k (1 + f) with sqrt(2)/2 <= 1 + f < sqrt(2).
+    int k;
+    double m = std::frexp(x, &k);
+    if (m < 0.70710678118654752440) {
+        m *= 2;
+        --k;
+    }
+    double f = m - 1;
+    double hfsq = 0.5 * f * f;
+    double s = f / (2 + f);
+    double z = s * s;
+    double w = z * z;
+    double R = z * (Lg1 + w * (Lg3 + w * (Lg5 + w * Lg7))) + w * (Lg2 + w * (Lg4 + w * Lg6));
+    double dk = k;
+    return dk * ln2_hi - ((hfsq - (s * (hfsq + R) + dk * ln2_lo)) - f);
+}
+
+double hypot(double x, double y) {
+    return std::sqrt(x * x + y * y);
+}
+
+}  // namespace fixed_math
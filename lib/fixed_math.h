@@ -0,0 +1,35 @@
+#ifndef TRANSFORMATION_LIB_FIXED_MATH_H_
+#define TRANSFORMATION_LIB_FIXED_MATH_H_
+
+// Elementary functions built from +, -, *, /, sqrt and exact operations such
+// as frexp only, evaluated in a fixed order, so they return the same bits on
+// every IEEE 754 platform whatever the libm. Used by every conversion (through
+// elementary.h) when TRANSFORMATIONS_DETERMINISTIC is defined. Not always
+// correctly rounded: sine and cosine are within 1 ulp of glibc, tan and pow
+// within 3, the inverse functions and log within 2; cbrt is within 1 ulp of
+// the exact value.
+namespace fixed_math {
+
+// Accurate for |x| below 2^20 * pi / 2, far beyond any angle the
+// conversions produce.
+double sin(double x);
+double cos(double x);
+double tan(double x);
+// Whole and half-integer exponents, the only ones the series use; any
+// other exponent falls back to std::pow.
+double pow(double x, double y);
+// IEEE 754 requires a correctly rounded square root, so this is std::sqrt.
+double sqrt(double x);
+double atan(double x);
+double atan2(double y, double x);
+// atan2(x, sqrt(1 - x^2)); a few ulp near +-1.
+double asin(double x);
+double cbrt(double x);
+double log(double x);
+// sqrt(x^2 + y^2) without guarding against overflow, which needs coordinates
+// of more than 1e150.
+double hypot(double x, double y);
+
+}  // namespace fixed_math
+
+#endif  // TRANSFORMATION_LIB_FIXED_MATH_H_
@@ -0,0 +1,810 @@
+#include "geodesic.h"
+
+#include "elementary.h"
+#include "ellipsoid.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+
+constexpr int max_iterations = 200;
+constexpr double tolerance = 1e-12;
+
+// Vincenty's series coefficients A and B for u^2.
+double series_a(double u2) {
+    return 1 + u2 / 16384 * (4096 + u2 * (-768 + u2 * (320 - 175 * u2)));
+}
+double series_b(double u2) {
+    return u2 / 1024 * (256 + u2 * (-128 + u2 * (74 - 47 * u2)));
+}
+double delta_sigma(double B, double sin_sigma, double cos_sigma, double cos_2sigma_m) {
+    double c2 = cos_2sigma_m * cos_2sigma_m;
+    return B * sin_sigma * (cos_2sigma_m + B / 4 * (cos_sigma * (-1 + 2 * c2) -
+        B / 6 * cos_2sigma_m * (-3 + 4 * sin_sigma * sin_sigma) * (-3 + 4 * c2)));
+}
+
+// The inverse problem follows Karney, "Algorithms for geodesics" (2013), with
+// the sixth order series of GeographicLib; names match the paper.
+constexpr int order = 6;
+constexpr int max_newton = 20;
+constexpr int max_bisection = max_newton + std::numeric_limits<double>::digits + 10;
+constexpr double epsilon = std::numeric_limits<double>::epsilon();
+const double tiny = std::sqrt(std::numeric_limits<double>::min());
+const double tol2 = std::sqrt(epsilon);
+constexpr double tol1 = 200 * epsilon;
+const double xthresh = 1000 * tol2;
+const double not_a_number = std::numeric_limits<double>::quiet_NaN();
+
+double sq(double x) {
+    return x * x;
+}
+
+// Normalizes (x, y); the arguments here are sines and cosines, so the plain
+// square root cannot overflow and is much cheaper than hypot.
+void norm(double &x, double &y) {
+    double r = math::sqrt(x * x + y * y);
+    x /= r;
+    y /= r;
+}
+
+// Error-free sum: returns u + v rounded and stores the rounding error in t.
+double sum(double u, double v, double &t) {
+    double s = u + v;
+    double up = s - v;
+    double vpp = s - up;
+    up -= u;
+    vpp -= v;
+    t = s != 0 ? 0.0 - (up + vpp) : s;
+    return s;
+}
+
+double polyval(int n, const double *p, double x) {
+    double y = n < 0 ? 0 : *p++;
+    while (--n >= 0) {
+        y = y * x + *p++;
+    }
+    return y;
+}
+
+// Rounds tiny angles so that points close to the equator are on it.
+double ang_round(double x) {
+    const double z = 1.0 / 16;
+    double y = std::fabs(x);
+    y = y < z ? z - (z - y) : y;
+    return std::copysign(y, x);
+}
+
+double ang_normalize(double x) {
+    double y = std::remainder(x, 360.0);
+    return std::fabs(y) == 180 ? std::copysign(180.0, x) : y;
+}
+
+// y - x reduced to [-180, 180] with its rounding error in e.
+double ang_diff(double x, double y, double &e) {
+    double t;
+    double d = sum(std::remainder(-x, 360.0), std::remainder(y, 360.0), t);
+    d = sum(std::remainder(d, 360.0), t, e);
+    if (d == 0 || std::fabs(d) == 180) {
+        d = std::copysign(d, e == 0 ? y - x : -e);
+    }
+    return d;
+}
+
+// Sine and cosine of x + t degrees, exact at multiples of 90 degrees.
+void sincosde(double x, double t, double &sinx, double &cosx) {
+    double q = std::round(x / 90);
+    double r = ang_round(x - 90 * q + t) * radians_per_degree;
+    double s = math::sin(r), c = math::cos(r);
+    switch (static_cast<int>(q - 4 * std::floor(q / 4))) {
+        case 0: sinx = s; cosx = c; break;
+        case 1: sinx = c; cosx = -s; break;
+        case 2: sinx = -s; cosx = -c; break;
+        default: sinx = -c; cosx = s; break;
+    }
+    cosx += 0.0;
+    if (sinx == 0) {
+        sinx = std::copysign(sinx, x);
+    }
+}
+
+void sincosd(double x, double &sinx, double &cosx) {
+    double r = std::isfinite(x) ? std::fmod(x, 360.0) : not_a_number;
+    double q = std::isnan(r) ? 0 : std::round(r / 90);
+    r = (r - 90 * q) * radians_per_degree;
+    double s = math::sin(r), c = math::cos(r);
+    switch (static_cast<int>(q - 4 * std::floor(q / 4))) {
+        case 0: sinx = s; cosx = c; break;
+        case 1: sinx = c; cosx = -s; break;
+        case 2: sinx = -s; cosx = -c; break;
+        default: sinx = -c; cosx = s; break;
+    }
+    cosx += 0.0;
+    if (sinx == 0) {
+        sinx = std::copysign(sinx, x);
+    }
+}
+
+double atan2d(double y, double x) {
+    int q = 0;
+    if (std::fabs(y) > std::fabs(x)) {
+        std::swap(x, y);
+        q = 2;
+    }
+    if (std::signbit(x)) {
+        x = -x;
+        ++q;
+    }
+    double angle = math::atan2(y, x) * degrees_per_radian;
+    switch (q) {
+        case 1: return std::copysign(180.0, y) - angle;
+        case 2: return 90 - angle;
+        case 3: return -90 + angle;
+        default: return angle;
+    }
+}
+
+// Clenshaw summation of sum(c[l] * sin(2 l x), l = 1..n) when sinp, else
+// sum(c[l] * cos((2 l + 1) x), l = 0..n-1); c has n + sinp elements.
+double sin_cos_series(bool sinp, double sinx, double cosx, const double *c, int n) {
+    c += n + sinp;
+    double ar = 2 * (cosx - sinx) * (cosx + sinx);
+    double y0 = n & 1 ? *--c : 0, y1 = 0;
+    for (n /= 2; n--;) {
+        y1 = ar * y0 - y1 + *--c;
+        y0 = ar * y1 - y0 + *--c;
+    }
+    return sinp ? 2 * sinx * cosx * y0 : cosx * (y0 - y1);
+}
+
+// Positive root k of k^4 + 2 k^3 - (x^2 + y^2 - 1) k^2 - 2 y^2 k - y^2 = 0.
+double astroid(double x, double y) {
+    double p = sq(x), q = sq(y);
+    double r = (p + q - 1) / 6;
+    if (q == 0 && r <= 0) {
+        return 0;
+    }
+    double S = p * q / 4;
+    double r2 = sq(r), r3 = r * r2;
+    double disc = S * (S + 2 * r3);
+    double u = r;
+    if (disc >= 0) {
+        double T3 = S + r3;
+        T3 += T3 < 0 ? -math::sqrt(disc) : math::sqrt(disc);
+        double T = math::cbrt(T3);
+        u += T + (T != 0 ? r2 / T : 0);
+    } else {
+        double angle = math::atan2(math::sqrt(-disc), -(S + r3));
+        u += 2 * r * math::cos(angle / 3);
+    }
+    double v = math::sqrt(sq(u) + q);
+    double uv = u < 0 ? q / (v - u) : u + v;
+    double w = (uv - q) / (2 * v);
+    return uv / (math::sqrt(uv + sq(w)) + w);
+}
+
+// The series A1, C1, A2 and C2 of the paper written out, so that the
+// power-of-two divisors fold into multiplications.
+double a1m1(double eps) {
+    double eps2 = sq(eps);
+    double t = eps2 * (eps2 * (eps2 + 4) + 64) / 256;
+    return (t + eps) / (1 - eps);
+}
+
+void c1(double eps, double *c) {
+    double eps2 = sq(eps), d = eps;
+    c[1] = d * ((6 - eps2) * eps2 - 16) / 32;
+    d *= eps;
+    c[2] = d * ((64 - 9 * eps2) * eps2 - 128) / 2048;
+    d *= eps;
+    c[3] = d * (9 * eps2 - 16) / 768;
+    d *= eps;
+    c[4] = d * (3 * eps2 - 5) / 512;
+    d *= eps;
+    c[5] = d * -7 / 1280;
+    d *= eps;
+    c[6] = d * -7 / 2048;
+}
+
+double a2m1(double eps) {
+    double eps2 = sq(eps);
+    double t = eps2 * (eps2 * (-11 * eps2 - 28) - 192) / 256;
+    return (t - eps) / (1 + eps);
+}
+
+void c2(double eps, double *c) {
+    double eps2 = sq(eps), d = eps;
+    c[1] = d * ((eps2 + 2) * eps2 + 16) / 32;
+    d *= eps;
+    c[2] = d * ((35 * eps2 + 64) * eps2 + 384) / 2048;
+    d *= eps;
+    c[3] = d * (15 * eps2 + 80) / 768;
+    d *= eps;
+    c[4] = d * (7 * eps2 + 35) / 512;
+    d *= eps;
+    c[5] = d * 63 / 1280;
+    d *= eps;
+    c[6] = d * 77 / 2048;
+}
+
+// Distance s12 / b when distance is set, and the reduced length m12 / b when
+// reduced is set; c1a and c2a are scratch series of order + 1 elements.
+void lengths(double eps, double sig12, double ssig1, double csig1, double dn1, double ssig2, double csig2,
+             double dn2, bool distance, bool reduced, double *c1a, double *c2a, double &s12b, double &m12b) {
+    double A1 = a1m1(eps);
+    c1(eps, c1a);
+    double A2 = 0, m0x = 0;
+    if (reduced) {
+        A2 = a2m1(eps);
+        c2(eps, c2a);
+        m0x = A1 - A2;
+        A2 = 1 + A2;
+    }
+    A1 = 1 + A1;
+    double J12 = 0;
+    if (distance) {
+        double B1 = sin_cos_series(true, ssig2, csig2, c1a, order) - sin_cos_series(true, ssig1, csig1, c1a, order);
+        s12b = A1 * (sig12 + B1);
+        if (reduced) {
+            double B2 = sin_cos_series(true, ssig2, csig2, c2a, order) -
+                        sin_cos_series(true, ssig1, csig1, c2a, order);
+            J12 = m0x * sig12 + (A1 * B1 - A2 * B2);
+        }
+    } else if (reduced) {
+        for (int l = 1; l <= order; ++l) {
+            c2a[l] = A1 * c1a[l] - A2 * c2a[l];
+        }
+        J12 = m0x * sig12 + (sin_cos_series(true, ssig2, csig2, c2a, order) -
+                             sin_cos_series(true, ssig1, csig1, c2a, order));
+    }
+    if (reduced) {
+        m12b = dn2 * (csig1 * ssig2) - dn1 * (ssig1 * csig2) - csig1 * csig2 * J12;
+    }
+}
+
+// +1 or -1 when the edge crosses the prime meridian eastwards or westwards.
+int transit(double longitude1, double longitude2) {
+    double e;
+    double lon12 = ang_diff(longitude1, longitude2, e);
+    longitude1 = ang_normalize(longitude1);
+    longitude2 = ang_normalize(longitude2);
+    if (lon12 > 0 && ((longitude1 < 0 && longitude2 >= 0) || (longitude1 > 0 && longitude2 == 0))) {
+        return 1;
+    }
+    return lon12 < 0 && longitude1 >= 0 && longitude2 < 0 ? -1 : 0;
+}
+
+}  // namespace
+
+Geodesic::Geodesic(ELLIPSOID which) {
+    Ellipsoid e = ellipsoid(which);
+    _a = e.a;
+    _f = e.f;
+    _f1 = 1 - _f;
+    _b = e.b();
+    _e2 = e.e2();
+    _ep2 = _e2 / sq(_f1);
+    _n = _f / (2 - _f);
+    double ecc = math::sqrt(_e2);
+    _c2 = (sq(_a) + sq(_b) * math::log((1 + ecc) / (1 - ecc)) / (2 * ecc)) / 2;
+    _etol2 = 0.1 * tol2 / math::sqrt(std::max(0.001, std::fabs(_f)) * std::min(1.0, 1 - _f / 2) / 2);
+
+    static const double a3[] = {
+        -3, 128,
+        -2, -3, 64,
+        -1, -3, -1, 16,
+        3, -1, -2, 8,
+        1, -1, 2,
+        1, 1,
+    };
+    int o = 0, k = 0;
+    for (int j = order - 1; j >= 0; --j) {
+        int m = std::min(order - j - 1, j);
+        _a3x[k++] = polyval(m, a3 + o, _n) / a3[o + m + 1];
+        o += m + 2;
+    }
+
+    static const double c3[] = {
+        3, 128,
+        2, 5, 128,
+        -1, 3, 3, 64,
+        -1, 0, 1, 8,
+        -1, 1, 4,
+        5, 256,
+        1, 3, 128,
+        -3, -2, 3, 64,
+        1, -3, 2, 32,
+        7, 512,
+        -10, 9, 384,
+        5, -9, 5, 192,
+        7, 512,
+        -14, 7, 512,
+        21, 2560,
+    };
+    o = 0;
+    k = 0;
+    for (int l = 1; l < order; ++l) {
+        for (int j = order - 1; j >= l; --j) {
+            int m = std::min(order - j - 1, j);
+            _c3x[k++] = polyval(m, c3 + o, _n) / c3[o + m + 1];
+            o += m + 2;
+        }
+    }
+
+    static const double c4[] = {
+        97, 15015,
+        1088, 156, 45045,
+        -224, -4784, 1573, 45045,
+        -10656, 14144, -4576, -858, 45045,
+        64, 624, -4576, 6864, -3003, 15015,
+        100, 208, 572, 3432, -12012, 30030, 45045,
+        1, 9009,
+        -2944, 468, 135135,
+        5792, 1040, -1287, 135135,
+        5952, -11648, 9152, -2574, 135135,
+        -64, -624, 4576, -6864, 3003, 135135,
+        8, 10725,
+        1856, -936, 225225,
+        -8448, 4992, -1144, 225225,
+        -1440, 4160, -4576, 1716, 225225,
+        -136, 63063,
+        1024, -208, 105105,
+        3584, -3328, 1144, 315315,
+        -128, 135135,
+        -2560, 832, 405405,
+        128, 99099,
+    };
+    o = 0;
+    k = 0;
+    for (int l = 0; l < order; ++l) {
+        for (int j = order - 1; j >= l; --j) {
+            int m = order - j - 1;
+            _c4x[k++] = polyval(m, c4 + o, _n) / c4[o + m + 1];
+            o += m + 2;
+        }
+    }
+}
+
+double Geodesic::a3(double eps) const {
+    return polyval(order - 1, _a3x, eps);
+}
+
+void Geodesic::c3(double eps, double *c) const {
+    double mult = 1;
+    int o = 0;
+    for (int l = 1; l < order; ++l) {
+        int m = order - l - 1;
+        mult *= eps;
+        c[l] = mult * polyval(m, _c3x + o, eps);
+        o += m + 1;
+    }
+}
+
+void Geodesic::c4(double eps, double *c) const {
+    double mult = 1;
+    int o = 0;
+    for (int l = 0; l < order; ++l) {
+        int m = order - l - 1;
+        c[l] = mult * polyval(m, _c4x + o, eps);
+        o += m + 1;
+        mult *= eps;
+    }
+}
+
+Geodesic::Reduced Geodesic::reduce(double latitude) const {
+    Reduced point;
+    point.latitude = ang_round(std::fabs(latitude) > 90 ? not_a_number : latitude);
+    sincosd(point.latitude, point.sbet, point.cbet);
+    point.sbet *= _f1;
+    norm(point.sbet, point.cbet);
+    point.cbet = std::max(tiny, point.cbet);
+    return point;
+}
+
+// Starting azimuth for Newton's method. Returns sig12 >= 0 (and sets alp2 and
+// dnm) when the line is short enough to be solved directly, -1 otherwise.
+double Geodesic::start(double sbet1, double cbet1, double sbet2, double cbet2, double lam12, double slam12,
+                       double clam12, double &salp1, double &calp1, double &salp2, double &calp2,
+                       double &dnm) const {
+    double sig12 = -1;
+    salp2 = calp2 = dnm = not_a_number;
+    double sbet12 = sbet2 * cbet1 - cbet2 * sbet1;
+    double cbet12 = cbet2 * cbet1 + sbet2 * sbet1;
+    double sbet12a = sbet2 * cbet1 + cbet2 * sbet1;
+    bool shortline = cbet12 >= 0 && sbet12 < 0.5 && cbet2 * lam12 < 0.5;
+    double somg12, comg12;
+    if (shortline) {
+        double sbetm2 = sq(sbet1 + sbet2);
+        sbetm2 /= sbetm2 + sq(cbet1 + cbet2);
+        dnm = math::sqrt(1 + _ep2 * sbetm2);
+        double omg12 = lam12 / (_f1 * dnm);
+        somg12 = math::sin(omg12);
+        comg12 = math::cos(omg12);
+    } else {
+        somg12 = slam12;
+        comg12 = clam12;
+    }
+
+    salp1 = cbet2 * somg12;
+    calp1 = comg12 >= 0 ? sbet12 + cbet2 * sbet1 * sq(somg12) / (1 + comg12)
+                        : sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+    double ssig12 = math::sqrt(sq(salp1) + sq(calp1));
+    double csig12 = sbet1 * sbet2 + cbet1 * cbet2 * comg12;
+
+    if (shortline && ssig12 < _etol2) {
+        salp2 = cbet1 * somg12;
+        calp2 = sbet12 - cbet1 * sbet2 * (comg12 >= 0 ? sq(somg12) / (1 + comg12) : 1 - comg12);
+        norm(salp2, calp2);
+        sig12 = math::atan2(ssig12, csig12);
+    } else if (!(std::fabs(_n) >= 0.1 || csig12 >= 0 || ssig12 >= 6 * std::fabs(_n) * pi * sq(cbet1))) {
+        // Nearly antipodal: scale to the astroid coordinates, where the
+        // antipode is at the origin and the singular point at (-1, 0).
+        double lam12x = math::atan2(-slam12, -clam12);
+        double k2 = sq(sbet1) * _ep2;
+        double eps = k2 / (2 * (1 + math::sqrt(1 + k2)) + k2);
+        double lamscale = _f * cbet1 * a3(eps) * pi;
+        double betscale = lamscale * cbet1;
+        double x = lam12x / lamscale;
+        double y = sbet12a / betscale;
+        if (y > -tol1 && x > -1 - xthresh) {
+            salp1 = std::min(1.0, -x);
+            calp1 = -math::sqrt(1 - sq(salp1));
+        } else {
+            double k = astroid(x, y);
+            double omg12a = lamscale * (-x * k / (1 + k));
+            somg12 = math::sin(omg12a);
+            comg12 = -math::cos(omg12a);
+            salp1 = cbet2 * somg12;
+            calp1 = sbet12a - cbet2 * sbet1 * sq(somg12) / (1 - comg12);
+        }
+    }
+    if (!(salp1 <= 0)) {
+        norm(salp1, calp1);
+    } else {
+        salp1 = 1;
+        calp1 = 0;
+    }
+    return sig12;
+}
+
+// Longitude difference lam12 reached by the geodesic leaving point 1 at
+// azimuth alp1, less the target lam120; dlam12 is its derivative.
+double Geodesic::lambda12(double sbet1, double cbet1, double dn1, double sbet2, double cbet2, double dn2,
+                          double salp1, double calp1, double slam120, double clam120, bool diffp,
+                          double &salp2, double &calp2, double &sig12, double &ssig1, double &csig1,
+                          double &ssig2, double &csig2, double &eps, double &domg12, double &dlam12) const {
+    if (sbet1 == 0 && calp1 == 0) {
+        calp1 = -tiny;
+    }
+    double salp0 = salp1 * cbet1;
+    double calp0 = math::sqrt(sq(calp1) + sq(salp1 * sbet1));
+
+    ssig1 = sbet1;
+    double somg1 = salp0 * sbet1;
+    csig1 = calp1 * cbet1;
+    double comg1 = csig1;
+    norm(ssig1, csig1);
+
+    salp2 = cbet2 != cbet1 ? salp0 / cbet2 : salp1;
+    calp2 = cbet2 != cbet1 || std::fabs(sbet2) != -sbet1
+        ? math::sqrt(sq(calp1 * cbet1) + (cbet1 < -sbet1 ? (cbet2 - cbet1) * (cbet1 + cbet2)
+                                                         : (sbet1 - sbet2) * (sbet1 + sbet2))) / cbet2
+        : std::fabs(calp1);
+    ssig2 = sbet2;
+    double somg2 = salp0 * sbet2;
+    csig2 = calp2 * cbet2;
+    double comg2 = csig2;
+    norm(ssig2, csig2);
+
+    sig12 = math::atan2(std::max(0.0, csig1 * ssig2 - ssig1 * csig2) + 0.0, csig1 * csig2 + ssig1 * ssig2);
+    double somg12 = std::max(0.0, comg1 * somg2 - somg1 * comg2) + 0.0;
+    double comg12 = comg1 * comg2 + somg1 * somg2;
+    double eta = math::atan2(somg12 * clam120 - comg12 * slam120, comg12 * clam120 + somg12 * slam120);
+
+    double k2 = sq(calp0) * _ep2;
+    eps = k2 / (2 * (1 + math::sqrt(1 + k2)) + k2);
+    double c3a[order];
+    c3(eps, c3a);
+    double B312 = sin_cos_series(true, ssig2, csig2, c3a, order - 1) -
+                  sin_cos_series(true, ssig1, csig1, c3a, order - 1);
+    domg12 = -_f * a3(eps) * salp0 * (sig12 + B312);
+    double lam12 = eta + domg12;
+
+    if (!diffp) {
+        dlam12 = not_a_number;
+    } else if (calp2 == 0) {
+        dlam12 = -2 * _f1 * dn1 / sbet1;
+    } else {
+        double c1a[order + 1], c2a[order + 1], s12b;
+        lengths(eps, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, false, true, c1a, c2a, s12b, dlam12);
+        dlam12 *= _f1 / (calp2 * cbet2);
+    }
+    return lam12;
+}
+
+Geodesic::Inverse Geodesic::solve(const Reduced &point1, double longitude1, const Reduced &point2,
+                                  double longitude2, double *S12) const {
+    // Bring the problem to 0 <= lon12 <= 180, -90 <= lat1 <= 0 and
+    // lat1 <= lat2 <= -lat1; the signs record how to undo it.
+    double lon12s;
+    double lon12 = ang_diff(longitude1, longitude2, lon12s);
+    double lonsign = std::signbit(lon12) ? -1 : 1;
+    lon12 *= lonsign;
+    lon12s *= lonsign;
+    double lam12 = lon12 * radians_per_degree;
+    double slam12, clam12;
+    sincosde(lon12, lon12s, slam12, clam12);
+    lon12s = (180 - lon12) - lon12s;
+
+    const Reduced *p1 = &point1, *p2 = &point2;
+    double swapp = std::fabs(p1->latitude) < std::fabs(p2->latitude) || std::isnan(p2->latitude) ? -1 : 1;
+    if (swapp < 0) {
+        lonsign *= -1;
+        std::swap(p1, p2);
+    }
+    double latsign = std::signbit(p1->latitude) ? 1 : -1;
+    double lat1 = p1->latitude * latsign;
+    double sbet1 = p1->sbet * latsign, cbet1 = p1->cbet;
+    double sbet2 = p2->sbet * latsign, cbet2 = p2->cbet;
+    if (cbet1 < -sbet1) {
+        if (cbet2 == cbet1) {
+            sbet2 = std::copysign(sbet1, sbet2);
+        }
+    } else if (std::fabs(sbet2) == -sbet1) {
+        cbet2 = cbet1;
+    }
+    double dn1 = math::sqrt(1 + _ep2 * sq(sbet1));
+    double dn2 = math::sqrt(1 + _ep2 * sq(sbet2));
+
+    double c1a[order + 1], c2a[order + 1];
+    double sig12, s12x = not_a_number, m12x = not_a_number;
+    double salp1, calp1, salp2, calp2;
+    bool meridian = lat1 == -90 || slam12 == 0;
+    if (meridian) {
+        calp1 = clam12;
+        salp1 = slam12;
+        calp2 = 1;
+        salp2 = 0;
+        double ssig1 = sbet1, csig1 = calp1 * cbet1;
+        double ssig2 = sbet2, csig2 = calp2 * cbet2;
+        sig12 = math::atan2(std::max(0.0, csig1 * ssig2 - ssig1 * csig2) + 0.0, csig1 * csig2 + ssig1 * ssig2);
+        lengths(_n, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, true, true, c1a, c2a, s12x, m12x);
+        // A meridian is the shortest path unless the reduced length turns
+        // negative, i.e. the pair is too close to antipodal.
+        if (sig12 < tol2 || m12x >= 0) {
+            if (sig12 < 3 * tiny || (sig12 < epsilon && (s12x < 0 || m12x < 0))) {
+                s12x = 0;
+            }
+            s12x *= _b;
+        } else {
+            meridian = false;
+        }
+    }
+
+    double somg12 = 2, comg12 = 0, omg12 = 0;
+    if (!meridian && sbet1 == 0 && (_f <= 0 || lon12s >= _f * 180)) {
+        // Along the equator.
+        calp1 = calp2 = 0;
+        salp1 = salp2 = 1;
+        s12x = _a * lam12;
+        omg12 = lam12 / _f1;
+    } else if (!meridian) {
+        double dnm;
+        sig12 = start(sbet1, cbet1, sbet2, cbet2, lam12, slam12, clam12, salp1, calp1, salp2, calp2, dnm);
+        if (sig12 >= 0) {
+            s12x = sig12 * _b * dnm;
+            omg12 = lam12 / (_f1 * dnm);
+        } else {
+            // Newton's method on alp1, falling back to bisection of the
+            // bracket (alp1a, alp1b) whenever a step leaves it.
+            double ssig1 = 0, csig1 = 0, ssig2 = 0, csig2 = 0, eps = 0, domg12 = 0;
+            double salp1a = tiny, calp1a = 1, salp1b = tiny, calp1b = -1;
+            bool tripn = false, tripb = false;
+            for (int iteration = 0;; ) {
+                double dv;
+                double v = lambda12(sbet1, cbet1, dn1, sbet2, cbet2, dn2, salp1, calp1, slam12, clam12,
+                                    iteration < max_newton, salp2, calp2, sig12, ssig1, csig1, ssig2, csig2, eps,
+                                    domg12, dv);
+                if (tripb || !(std::fabs(v) >= (tripn ? 8 : 1) * epsilon) || iteration == max_bisection) {
+                    break;
+                }
+                if (v > 0 && (iteration > max_newton || calp1 / salp1 > calp1b / salp1b)) {
+                    salp1b = salp1;
+                    calp1b = calp1;
+                } else if (v < 0 && (iteration > max_newton || calp1 / salp1 < calp1a / salp1a)) {
+                    salp1a = salp1;
+                    calp1a = calp1;
+                }
+                ++iteration;
+                if (iteration < max_newton && dv > 0) {
+                    double dalp1 = -v / dv;
+                    if (std::fabs(dalp1) < pi) {
+                        double sdalp1 = math::sin(dalp1), cdalp1 = math::cos(dalp1);
+                        double nsalp1 = salp1 * cdalp1 + calp1 * sdalp1;
+                        if (nsalp1 > 0) {
+                            calp1 = calp1 * cdalp1 - salp1 * sdalp1;
+                            salp1 = nsalp1;
+                            norm(salp1, calp1);
+                            tripn = std::fabs(v) <= 16 * epsilon;
+                            continue;
+                        }
+                    }
+                }
+                salp1 = (salp1a + salp1b) / 2;
+                calp1 = (calp1a + calp1b) / 2;
+                norm(salp1, calp1);
+                tripn = false;
+                tripb = std::fabs(salp1a - salp1) + (calp1a - calp1) < epsilon ||
+                        std::fabs(salp1 - salp1b) + (calp1 - calp1b) < epsilon;
+            }
+            lengths(eps, sig12, ssig1, csig1, dn1, ssig2, csig2, dn2, true, false, c1a, c2a, s12x, m12x);
+            s12x *= _b;
+            if (S12) {
+                double sdomg12 = math::sin(domg12), cdomg12 = math::cos(domg12);
+                somg12 = slam12 * cdomg12 - clam12 * sdomg12;
+                comg12 = clam12 * cdomg12 + slam12 * sdomg12;
+            }
+        }
+    }
+
+    if (S12) {
+        // Area between the geodesic and the equator, as in section 6 of the
+        // paper: the ellipsoidal correction plus c^2 times the spherical
+        // excess.
+        double salp0 = salp1 * cbet1;
+        double calp0 = math::sqrt(sq(calp1) + sq(salp1 * sbet1));
+        double area = 0;
+        if (calp0 != 0 && salp0 != 0) {
+            double ssig1 = sbet1, csig1 = calp1 * cbet1;
+            double ssig2 = sbet2, csig2 = calp2 * cbet2;
+            double k2 = sq(calp0) * _ep2;
+            double eps = k2 / (2 * (1 + math::sqrt(1 + k2)) + k2);
+            double A4 = sq(_a) * calp0 * salp0 * _e2;
+            norm(ssig1, csig1);
+            norm(ssig2, csig2);
+            double c4a[order];
+            c4(eps, c4a);
+            area = A4 * (sin_cos_series(false, ssig2, csig2, c4a, order) -
+                         sin_cos_series(false, ssig1, csig1, c4a, order));
+        }
+        if (!meridian && somg12 == 2) {
+            somg12 = math::sin(omg12);
+            comg12 = math::cos(omg12);
+        }
+        double alp12;
+        if (!meridian && comg12 > -0.7071 && sbet2 - sbet1 < 1.75) {
+            double domg12 = 1 + comg12, dbet1 = 1 + cbet1, dbet2 = 1 + cbet2;
+            alp12 = 2 * math::atan2(somg12 * (sbet1 * dbet2 + sbet2 * dbet1),
+                                    domg12 * (sbet1 * sbet2 + dbet1 * dbet2));
+        } else {
+            double salp12 = salp2 * calp1 - calp2 * salp1;
+            double calp12 = calp2 * calp1 + salp2 * salp1;
+            if (salp12 == 0 && calp12 < 0) {
+                salp12 = tiny * calp1;
+                calp12 = -1;
+            }
+            alp12 = math::atan2(salp12, calp12);
+        }
+        area += _c2 * alp12;
+        *S12 = 0.0 + area * swapp * lonsign * latsign;
+    }
+
+    if (swapp < 0) {
+        std::swap(salp1, salp2);
+        std::swap(calp1, calp2);
+    }
+    salp1 *= swapp * lonsign;
+    calp1 *= swapp * latsign;
+    salp2 *= swapp * lonsign;
+    calp2 *= swapp * latsign;
+    return Inverse{0.0 + s12x, Degree{atan2d(salp1, calp1)}, Degree{atan2d(salp2, calp2)}};
+}
+
+Geodesic::Inverse Geodesic::inverse(Degree latitude1, Degree longitude1, Degree latitude2, Degree longitude2) const {
+    return solve(reduce(latitude1), longitude1, reduce(latitude2), longitude2, nullptr);
+}
+
+Geodesic::Direct Geodesic::direct(Degree latitude, Degree longitude, Degree azimuth, double distance) const {
+    Radian alpha1 = azimuth;
+    double sin_alpha1 = math::sin(alpha1), cos_alpha1 = math::cos(alpha1);
+    double tanU1 = (1 - _f) * math::tan(Radian{latitude});
+    double cosU1 = 1 / math::sqrt(1 + tanU1 * tanU1);
+    double sinU1 = tanU1 * cosU1;
+    double sigma1 = math::atan2(tanU1, cos_alpha1);
+    double sin_alpha = cosU1 * sin_alpha1;
+    double cos2_alpha = 1 - sin_alpha * sin_alpha;
+    double u2 = cos2_alpha * (_a * _a - _b * _b) / (_b * _b);
+    double A = series_a(u2);
+    double B = series_b(u2);
+
+    double sigma = distance / (_b * A);
+    double sin_sigma = 0, cos_sigma = 0, cos_2sigma_m = 0;
+    for (int iteration = 0; iteration < max_iterations; ++iteration) {
+        cos_2sigma_m = math::cos(2 * sigma1 + sigma);
+        sin_sigma = math::sin(sigma);
+        cos_sigma = math::cos(sigma);
+        double previous = sigma;
+        sigma = distance / (_b * A) + delta_sigma(B, sin_sigma, cos_sigma, cos_2sigma_m);
+        if (std::fabs(sigma - previous) < tolerance) {
+            break;
+        }
+    }
+    cos_2sigma_m = math::cos(2 * sigma1 + sigma);
+    sin_sigma = math::sin(sigma);
+    cos_sigma = math::cos(sigma);
+
+    double t = sinU1 * sin_sigma - cosU1 * cos_sigma * cos_alpha1;
+    double phi2 = math::atan2(sinU1 * cos_sigma + cosU1 * sin_sigma * cos_alpha1,
+                        (1 - _f) * math::sqrt(sin_alpha * sin_alpha + t * t));
+    double lambda = math::atan2(sin_sigma * sin_alpha1, cosU1 * cos_sigma - sinU1 * sin_sigma * cos_alpha1);
+    double C = _f / 16 * cos2_alpha * (4 + _f * (4 - 3 * cos2_alpha));
+    double L = lambda - (1 - C) * _f * sin_alpha *
+        (sigma + C * sin_sigma * (cos_2sigma_m + C * cos_sigma * (-1 + 2 * cos_2sigma_m * cos_2sigma_m)));
+    return Direct{Radian{phi2}, Degree{longitude + Degree{Radian{L}}}, Radian{math::atan2(sin_alpha, -t)}};
+}
+
+
+std::vector<double> Geodesic::distances(const double *from_latitude, const double *from_longitude,
+                                        std::size_t from_count, const double *to_latitude,
+                                        const double *to_longitude, std::size_t to_count) const {
+    // The latitude trigonometry is done once per point, not once per pair.
+    std::vector<Reduced> from(from_count), to(to_count);
+    for (std::size_t i = 0; i < from_count; ++i) {
+        from[i] = reduce(from_latitude[i]);
+    }
+    for (std::size_t j = 0; j < to_count; ++j) {
+        to[j] = reduce(to_latitude[j]);
+    }
+
+    std::vector<double> result(from_count * to_count);
+    auto rows = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            for (std::size_t j = 0; j < to_count; ++j) {
+                result[i * to_count + j] = solve(from[i], from_longitude[i], to[j], to_longitude[j], nullptr).distance;
+            }
+        }
+    };
+
+    // Rows of at least 4096 pairs per task.
+    std::size_t grain = (4096 + to_count - 1) / std::max<std::size_t>(to_count, 1);
+    ThreadPool::shared().parallel_for(from_count, grain, rows);
+    return result;
+}
+
+double Geodesic::area(const double *latitude, const double *longitude, std::size_t count) const {
+    if (count < 3) {
+        return 0;
+    }
+    // Sum of the areas between each edge and the equator, kept with its
+    // rounding error. An odd number of prime meridian crossings means the ring
+    // encircles a pole, which shifts the sum by half the ellipsoid's area.
+    double total = 0, error = 0;
+    int crossings = 0;
+    std::size_t previous = count - 1;
+    Reduced point1 = reduce(latitude[previous]);
+    for (std::size_t i = 0; i < count; ++i) {
+        Reduced point2 = reduce(latitude[i]);
+        double S12, t;
+        solve(point1, longitude[previous], point2, longitude[i], &S12);
+        total = sum(total, S12, t);
+        error += t;
+        crossings += transit(longitude[previous], longitude[i]);
+        point1 = point2;
+        previous = i;
+    }
+
+    double area0 = 4 * pi * _c2;
+    double area = std::remainder(total, area0) + error;
+    if (crossings & 1) {
+        area += (area < 0 ? 1 : -1) * area0 / 2;
+    }
+    if (area > area0 / 2) {
+        area -= area0;
+    } else if (area <= -area0 / 2) {
+        area += area0;
+    }
+    return std::fabs(area);
+}
@@ -0,0 +1,109 @@
+#ifndef TRANSFORMATION_LIB_GEODESIC_H_
+#define TRANSFORMATION_LIB_GEODESIC_H_
+
+#include "transformations.h"
+
+#include <cstddef>
+#include <vector>
+
+// Geodesic problems on one of the supported ellipsoids. inverse() follows
+// Karney's algorithm, which converges for every pair including nearly
+// antipodal ones (accurate to about 15 nm); direct() uses Vincenty's series.
+class Geodesic {
+ public:
+    explicit Geodesic(ELLIPSOID ellipsoid);
+
+    struct Inverse {
+        double distance;
+        Degree azimuth1;
+        Degree azimuth2;
+    };
+    struct Direct {
+        Degree latitude;
+        Degree longitude;
+        Degree azimuth;
+    };
+
+    Inverse inverse(Degree latitude1, Degree longitude1, Degree latitude2, Degree longitude2) const;
+    Direct direct(Degree latitude, Degree longitude, Degree azimuth, double distance) const;
+
+    // Row-major |from| x |to| matrix of distances, rows split across the shared
+    // thread pool.
+    // The latitude terms are computed once per point rather than per pair.
+    std::vector<double> distances(const double *from_latitude, const double *from_longitude, std::size_t from_count,
+                                  const double *to_latitude, const double *to_longitude, std::size_t to_count) const;
+    template <class Point>
+    std::vector<double> distances(const std::vector<Point> &from, const std::vector<Point> &to) const;
+
+    // Area in square metres of a simple polygon given by its vertices (the
+    // ring is closed implicitly), with geodesic edges on the ellipsoid. The
+    // orientation does not matter; a ring enclosing more than half of the
+    // ellipsoid reports the area of its complement.
+    double area(const double *latitude, const double *longitude, std::size_t count) const;
+    template <class Point>
+    double area(const std::vector<Point> &ring) const;
+
+ private:
+    // Reduced latitude of a point, with the sines and cosines the inverse
+    // problem needs.
+    struct Reduced {
+        double latitude;
+        double sbet;
+        double cbet;
+    };
+    Reduced reduce(double latitude) const;
+    // Inverse problem between reduced points; also sets the area between the
+    // geodesic and the equator when S12 is not null.
+    Inverse solve(const Reduced &point1, double longitude1, const Reduced &point2, double longitude2,
+                  double *S12) const;
+    double start(double sbet1, double cbet1, double sbet2, double cbet2, double lam12, double slam12,
+                 double clam12, double &salp1, double &calp1, double &salp2, double &calp2, double &dnm) const;
+    double lambda12(double sbet1, double cbet1, double dn1, double sbet2, double cbet2, double dn2,
+                    double salp1, double calp1, double slam120, double clam120, bool diffp,
+                    double &salp2, double &calp2, double &sig12, double &ssig1, double &csig1,
+                    double &ssig2, double &csig2, double &eps, double &domg12, double &dlam12) const;
+    double a3(double eps) const;
+    void c3(double eps, double *c) const;
+    void c4(double eps, double *c) const;
+
+    double _a;
+    double _f;
+    double _f1;
+    double _b;
+    double _e2;
+    double _ep2;
+    double _n;
+    // Authalic radius squared.
+    double _c2;
+    double _etol2;
+    double _a3x[6];
+    double _c3x[15];
+    double _c4x[21];
+};
+
+template <class Point>
+std::vector<double> Geodesic::distances(const std::vector<Point> &from, const std::vector<Point> &to) const {
+    std::vector<double> from_latitude, from_longitude, to_latitude, to_longitude;
+    for (const Point &point : from) {
+        from_latitude.push_back(point.latitude);
+        from_longitude.push_back(point.longitude);
+    }
+    for (const Point &point : to) {
+        to_latitude.push_back(point.latitude);
+        to_longitude.push_back(point.longitude);
+    }
+    return distances(from_latitude.data(), from_longitude.data(), from.size(),
+                     to_latitude.data(), to_longitude.data(), to.size());
+}
+
+template <class Point>
+double Geodesic::area(const std::vector<Point> &ring) const {
+    std::vector<double> latitude, longitude;
+    for (const Point &point : ring) {
+        latitude.push_back(point.latitude);
+        longitude.push_back(point.longitude);
+    }
+    return area(latitude.data(), longitude.data(), ring.size());
+}
+
+#endif  // TRANSFORMATION_LIB_GEODESIC_H_
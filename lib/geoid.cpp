@@ -0,0 +1,150 @@
+#include "geoid.h"
+
+#include "stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace {
+
+constexpr char magic[8] = {'G', 'E', 'O', 'I', 'D', '0', '1', '\0'};
+constexpr std::size_t header_size = 8 + 4 * sizeof(double) + 2 * sizeof(std::uint32_t);
+
+// Catmull-Rom weights for the fraction t between the two middle samples.
+void cubic_weights(double t, double w[4]) {
+    double t2 = t * t;
+    double t3 = t2 * t;
+    w[0] = (-t3 + 2 * t2 - t) / 2;
+    w[1] = (3 * t3 - 5 * t2 + 2) / 2;
+    w[2] = (-3 * t3 + 4 * t2 + t) / 2;
+    w[3] = (t3 - t2) / 2;
+}
+
+}  // namespace
+
+GeoidGrid::GeoidGrid(const std::string &path) : _file(path) {
+    const char *bytes = _file.data();
+    if (!bytes || _file.size() < header_size) {
+        return;
+    }
+    const char *field = bytes + sizeof(magic);
+    for (double *value : {&_header.latitude0, &_header.longitude0, &_header.step_latitude, &_header.step_longitude}) {
+        std::memcpy(value, field, sizeof(double));
+        field += sizeof(double);
+    }
+    std::memcpy(&_header.rows, field, sizeof(std::uint32_t));
+    std::memcpy(&_header.columns, field + sizeof(std::uint32_t), sizeof(std::uint32_t));
+    std::size_t expected = header_size + std::size_t{_header.rows} * _header.columns * sizeof(float);
+    if (std::memcmp(bytes, magic, sizeof(magic)) != 0 || _file.size() < expected ||
+        _header.rows < 2 || _header.columns < 2 || !(_header.step_latitude > 0) || !(_header.step_longitude > 0)) {
+        return;
+    }
+    _values = reinterpret_cast<const float *>(bytes + header_size);
+    _wraps = std::fabs(_header.columns * _header.step_longitude - 360) < 1e-9;
+}
+
+double GeoidGrid::value(long row, long column) const {
+    long columns = _header.columns;
+    if (_wraps) {
+        column = ((column % columns) + columns) % columns;
+    }
+    if (row < 0 || row >= static_cast<long>(_header.rows) || column < 0 || column >= columns) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return _values[row * columns + column];
+}
+
+double GeoidGrid::undulation(Degree latitude, Degree longitude, INTERPOLATION interpolation) const {
+    TRANSFORMATIONS_COUNTED(ROUTE::GEOID);
+    if (!valid()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double y = (latitude - _header.latitude0) / _header.step_latitude;
+    double x = longitude - _header.longitude0;
+    if (_wraps) {
+        x = std::fmod(x, 360.0);
+        if (x < 0) {
+            x += 360;
+        }
+    }
+    x /= _header.step_longitude;
+    double row = std::floor(y);
+    double column = std::floor(x);
+    // Points off the grid have no value; checking here also keeps NaN and huge
+    // coordinates away from the integer casts below.
+    if (!(row >= 0 && row < _header.rows) ||
+        !(_wraps ? std::isfinite(column) : column >= 0 && column < _header.columns)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double ty = y - row;
+    double tx = x - column;
+    long r = static_cast<long>(row);
+    long c = static_cast<long>(column);
+    // The last row/column is a valid sample, not the start of a cell.
+    if (r == static_cast<long>(_header.rows) - 1 && ty == 0) {
+        --r;
+        ty = 1;
+    }
+    if (!_wraps && c == static_cast<long>(_header.columns) - 1 && tx == 0) {
+        --c;
+        tx = 1;
+    }
+
+    if (interpolation == INTERPOLATION::BILINEAR) {
+        double v00 = value(r, c);
+        double v01 = value(r, c + 1);
+        double v10 = value(r + 1, c);
+        double v11 = value(r + 1, c + 1);
+        return (v00 * (1 - tx) + v01 * tx) * (1 - ty) + (v10 * (1 - tx) + v11 * tx) * ty;
+    }
+
+    // Bicubic needs a one-sample border; clamp it at the grid edges.
+    double wx[4];
+    double wy[4];
+    cubic_weights(tx, wx);
+    cubic_weights(ty, wy);
+    long last_row = static_cast<long>(_header.rows) - 1;
+    long last_column = static_cast<long>(_header.columns) - 1;
+    if (r < 0 || r + 1 > last_row || (!_wraps && (c < 0 || c + 1 > last_column))) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double sum = 0;
+    for (int i = 0; i < 4; ++i) {
+        long rr = std::max(0L, std::min(last_row, r - 1 + i));
+        double row_sum = 0;
+        for (int j = 0; j < 4; ++j) {
+            long cc = c - 1 + j;
+            if (!_wraps) {
+                cc = std::max(0L, std::min(last_column, cc));
+            }
+            row_sum += wx[j] * value(rr, cc);
+        }
+        sum += wy[i] * row_sum;
+    }
+    return sum;
+}
+
+void GeoidGrid::undulations(const double *latitude, const double *longitude, double *out, std::size_t n,
+                            INTERPOLATION interpolation) const {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = undulation(Degree{latitude[i]}, Degree{longitude[i]}, interpolation);
+    }
+}
+
+bool GeoidGrid::write(const std::string &path, const Header &header, const std::vector<float> &values) {
+    if (values.size() != std::size_t{header.rows} * header.columns) {
+        return false;
+    }
+    std::ofstream out(path, std::ios::binary);
+    out.write(magic, sizeof(magic));
+    for (double value : {header.latitude0, header.longitude0, header.step_latitude, header.step_longitude}) {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+    out.write(reinterpret_cast<const char *>(&header.rows), sizeof(header.rows));
+    out.write(reinterpret_cast<const char *>(&header.columns), sizeof(header.columns));
+    out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(float)));
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,55 @@
+#ifndef TRANSFORMATION_LIB_GEOID_H_
+#define TRANSFORMATION_LIB_GEOID_H_
+
+#include "mapped_file.h"
+#include "radian_degree.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class INTERPOLATION { BILINEAR, BICUBIC };
+
+// Geoid undulation grid (e.g. EGM2008 or a quasigeoid for the Baltic height
+// system) memory-mapped from a file, so only the pages that are touched are
+// read. The file is a 48-byte header followed by rows * columns float32
+// undulations in metres, row-major from the south-west corner:
+//     char magic[8] = "GEOID01"; double latitude0, longitude0, step_latitude,
+//     step_longitude (degrees); uint32_t rows, columns.
+// Grids spanning 360 degrees of longitude wrap around.
+class GeoidGrid {
+ public:
+    struct Header {
+        double latitude0;
+        double longitude0;
+        double step_latitude;
+        double step_longitude;
+        std::uint32_t rows;
+        std::uint32_t columns;
+    };
+
+    explicit GeoidGrid(const std::string &path);
+
+    // False if the file could not be mapped or is not a geoid grid.
+    bool valid() const { return _values != nullptr; }
+    const Header &header() const { return _header; }
+
+    // Undulation N in metres; NaN outside the grid.
+    double undulation(Degree latitude, Degree longitude,
+                      INTERPOLATION interpolation = INTERPOLATION::BILINEAR) const;
+    void undulations(const double *latitude, const double *longitude, double *out, std::size_t n,
+                     INTERPOLATION interpolation = INTERPOLATION::BILINEAR) const;
+
+    static bool write(const std::string &path, const Header &header, const std::vector<float> &values);
+
+ private:
+    double value(long row, long column) const;
+
+    MappedFile _file;
+    Header _header{};
+    const float *_values = nullptr;
+    bool _wraps = false;
+};
+
+#endif  // TRANSFORMATION_LIB_GEOID_H_
@@ -0,0 +1,293 @@
+#include "geometry.h"
+
+#include "elementary.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+
+constexpr int max_depth = 16;
+// Smaller geometries (about a millisecond of projections) are densified on
+// the calling thread; waking pool workers would not pay off.
+constexpr std::size_t parallel_vertices = 1024;
+
+struct Planar {
+    double x;
+    double y;
+};
+
+Planar planar(const WGS84 &wgs_84) {
+    return Planar{wgs_84.longitude, wgs_84.latitude};
+}
+Planar planar(const GaussKruger &gk) {
+    return Planar{gk.x, gk.y};
+}
+Planar planar(const UTM &utm) {
+    return Planar{utm.E, utm.N};
+}
+
+// Longitude of `b` shifted by whole turns to within 180 degrees of `a`, so
+// that segments across the antimeridian stay short.
+double unwrapped_longitude(const WGS84 &b, const WGS84 &a) {
+    return a.longitude + std::remainder(b.longitude - a.longitude, 360.0);
+}
+
+WGS84 midpoint(const WGS84 &a, const WGS84 &b) {
+    double longitude = (a.longitude + unwrapped_longitude(b, a)) / 2;
+    if (std::fabs(longitude) > 180) {
+        longitude -= std::copysign(360.0, longitude);
+    }
+    return WGS84{Degree{(a.latitude + b.latitude) / 2}, Degree{longitude}, (a.altitude + b.altitude) / 2};
+}
+GaussKruger midpoint(const GaussKruger &a, const GaussKruger &b) {
+    GaussKruger middle;
+    middle.x = (a.x + b.x) / 2;
+    middle.y = (a.y + b.y) / 2;
+    middle.height = (a.height + b.height) / 2;
+    return middle;
+}
+
+template <class Out, class In>
+Out project(const In &point);
+template <>
+GaussKruger project(const WGS84 &point) {
+    return GaussKruger{SK42{point}};
+}
+template <>
+UTM project(const WGS84 &point) {
+    return UTM{point};
+}
+template <>
+WGS84 project(const GaussKruger &point) {
+    return WGS84{SK42{point}};
+}
+
+struct VertexKey {
+    std::uint64_t bits[3];
+
+    explicit VertexKey(const WGS84 &point) {
+        double values[3] = {point.latitude, point.longitude, point.altitude};
+        std::memcpy(bits, values, sizeof(bits));
+    }
+    explicit VertexKey(const GaussKruger &point) {
+        double values[3] = {point.x, point.y, point.height};
+        std::memcpy(bits, values, sizeof(bits));
+    }
+    bool operator==(const VertexKey &other) const {
+        return bits[0] == other.bits[0] && bits[1] == other.bits[1] && bits[2] == other.bits[2];
+    }
+};
+
+struct VertexKeyHash {
+    std::size_t operator()(const VertexKey &key) const {
+        std::uint64_t h = key.bits[0] * 0x9e3779b97f4a7c15ull;
+        h = (h ^ key.bits[1]) * 0x9e3779b97f4a7c15ull;
+        h = (h ^ key.bits[2]) * 0x9e3779b97f4a7c15ull;
+        return static_cast<std::size_t>(h ^ (h >> 29));
+    }
+};
+
+// Distance from p to the segment ab.
+double deviation(Planar p, Planar a, Planar b) {
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double length2 = dx * dx + dy * dy;
+    double t = length2 > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / length2 : 0;
+    t = std::max(0.0, std::min(1.0, t));
+    return math::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+}
+template <class Point>
+double deviation(const Point &p, const Point &a, const Point &b) {
+    return deviation(planar(p), planar(a), planar(b));
+}
+double deviation(const WGS84 &p, const WGS84 &a, const WGS84 &b) {
+    return deviation(Planar{unwrapped_longitude(p, a), p.latitude}, planar(a),
+                     Planar{unwrapped_longitude(b, a), b.latitude});
+}
+
+template <class In, class Out, class Project>
+void densify(const In &a, const In &b, const Out &pa, const Out &pb, double tolerance, int depth,
+             const Project &project_one, std::vector<Out> &out) {
+    if (depth < max_depth) {
+        In middle = midpoint(a, b);
+        Out pm = project_one(middle);
+        if (deviation(pm, pa, pb) > tolerance) {
+            densify(a, middle, pa, pm, tolerance, depth + 1, project_one, out);
+            densify(middle, b, pm, pb, tolerance, depth + 1, project_one, out);
+            return;
+        }
+    }
+    out.push_back(pb);
+}
+
+template <class Out, class In, class Project>
+Geometry<Out> transform(const Geometry<In> &geometry, double tolerance, const Project &project_one) {
+    // Project every distinct vertex once.
+    std::unordered_map<VertexKey, std::size_t, VertexKeyHash> unique;
+    std::vector<std::size_t> slot(geometry.vertices.size());
+    std::vector<Out> projected;
+    for (std::size_t i = 0; i < geometry.vertices.size(); ++i) {
+        auto inserted = unique.emplace(VertexKey(geometry.vertices[i]), projected.size());
+        if (inserted.second) {
+            projected.push_back(project_one(geometry.vertices[i]));
+        }
+        slot[i] = inserted.first->second;
+    }
+
+    std::size_t parts = geometry.offsets.empty() ? 0 : geometry.offsets.size() - 1;
+    std::vector<std::vector<Out>> part_vertices(parts);
+    auto densify_parts = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t p = begin; p < end; ++p) {
+            std::size_t first = geometry.offsets[p];
+            std::size_t last = geometry.offsets[p + 1];
+            std::vector<Out> &out = part_vertices[p];
+            if (first == last) {
+                continue;
+            }
+            out.push_back(projected[slot[first]]);
+            for (std::size_t v = first + 1; v < last; ++v) {
+                densify(geometry.vertices[v - 1], geometry.vertices[v], projected[slot[v - 1]], projected[slot[v]],
+                        tolerance, 0, project_one, out);
+            }
+        }
+    };
+
+    if (geometry.vertices.size() < parallel_vertices) {
+        densify_parts(0, parts);
+    } else {
+        ThreadPool::shared().parallel_for(parts, 1, densify_parts);
+    }
+
+    Geometry<Out> result;
+    result.offsets.push_back(0);
+    for (std::vector<Out> &part : part_vertices) {
+        result.vertices.insert(result.vertices.end(), part.begin(), part.end());
+        result.offsets.push_back(result.vertices.size());
+    }
+    return result;
+}
+
+template <class Out, class In>
+Geometry<Out> transform(const Geometry<In> &geometry, double tolerance) {
+    return transform<Out>(geometry, tolerance, project<Out, In>);
+}
+
+// Projections pinned to one zone, so an envelope that straddles a zone
+// boundary or the equator is sampled in a single plane. The UTM northing
+// keeps the false northing of the pinned hemisphere on both sides.
+struct GaussKrugerInZone {
+    int zone;
+    GaussKruger operator()(const WGS84 &point) const {
+        return GaussKruger::in_zone(SK42{point}, zone);
+    }
+};
+struct UTMInZone {
+    int zone;
+    bool south;
+    UTM operator()(const WGS84 &point) const {
+        UTM utm = UTM::in_zone(point, zone);
+        if (south && point.latitude >= 0) {
+            utm.N += UTM::N0;
+        } else if (!south && point.latitude < 0) {
+            utm.N -= UTM::N0;
+        }
+        return utm;
+    }
+};
+
+// Densifies the boundary of `envelope` and returns the box around its image,
+// grown by the tolerance. The projections are continuous and one-to-one, so
+// the image of the box is bounded by the image of its boundary.
+template <class Out, class In, class Project>
+Envelope transform_envelope(const In &corner00, const In &corner10, const In &corner11, const In &corner01,
+                            double tolerance, const Project &project_one) {
+    Geometry<In> ring;
+    ring.vertices = {corner00, corner10, corner11, corner01, corner00};
+    ring.offsets = {0, ring.vertices.size()};
+    Geometry<Out> projected = transform<Out>(ring, tolerance, project_one);
+
+    double infinity = std::numeric_limits<double>::infinity();
+    Envelope result{infinity, infinity, -infinity, -infinity};
+    for (const Out &vertex : projected.vertices) {
+        Planar p = planar(vertex);
+        result.min_x = std::min(result.min_x, p.x);
+        result.min_y = std::min(result.min_y, p.y);
+        result.max_x = std::max(result.max_x, p.x);
+        result.max_y = std::max(result.max_y, p.y);
+    }
+    result.min_x -= tolerance;
+    result.min_y -= tolerance;
+    result.max_x += tolerance;
+    result.max_y += tolerance;
+    return result;
+}
+
+WGS84 geodetic_corner(double longitude, double latitude) {
+    return WGS84{Degree{latitude}, Degree{longitude}, 0};
+}
+WGS84 geodetic_centre(const Envelope &geodetic) {
+    return geodetic_corner((geodetic.min_x + geodetic.max_x) / 2, (geodetic.min_y + geodetic.max_y) / 2);
+}
+Envelope invalid_envelope() {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    return Envelope{nan, nan, nan, nan};
+}
+GaussKruger gauss_kruger_corner(double x, double y) {
+    GaussKruger corner;
+    corner.x = x;
+    corner.y = y;
+    corner.height = 0;
+    return corner;
+}
+
+}  // namespace
+
+Geometry<GaussKruger> to_gauss_kruger(const Geometry<WGS84> &geometry, double tolerance) {
+    return transform<GaussKruger>(geometry, tolerance);
+}
+Geometry<UTM> to_utm(const Geometry<WGS84> &geometry, double tolerance) {
+    return transform<UTM>(geometry, tolerance);
+}
+Geometry<WGS84> to_wgs84(const Geometry<GaussKruger> &geometry, double tolerance) {
+    return transform<WGS84>(geometry, tolerance);
+}
+
+Envelope envelope_to_gauss_kruger(const Envelope &geodetic, double tolerance) {
+    // The zone of the centre, as GaussKruger(SK42) would pick it.
+    double number = (6 + SK42{geodetic_centre(geodetic)}.longitude) / 6;
+    if (!(number >= 1 && number < 61)) {
+        return invalid_envelope();
+    }
+    int zone = static_cast<int>(number);
+    return transform_envelope<GaussKruger>(geodetic_corner(geodetic.min_x, geodetic.min_y),
+                                           geodetic_corner(geodetic.max_x, geodetic.min_y),
+                                           geodetic_corner(geodetic.max_x, geodetic.max_y),
+                                           geodetic_corner(geodetic.min_x, geodetic.max_y), tolerance,
+                                           GaussKrugerInZone{zone});
+}
+Envelope envelope_to_utm(const Envelope &geodetic, double tolerance) {
+    WGS84 centre = geodetic_centre(geodetic);
+    int zone = 0;
+    char letter = 0;
+    if (!UTM::parse_zone(UTM{centre}.zone, zone, letter)) {
+        return invalid_envelope();
+    }
+    return transform_envelope<UTM>(geodetic_corner(geodetic.min_x, geodetic.min_y),
+                                   geodetic_corner(geodetic.max_x, geodetic.min_y),
+                                   geodetic_corner(geodetic.max_x, geodetic.max_y),
+                                   geodetic_corner(geodetic.min_x, geodetic.max_y), tolerance,
+                                   UTMInZone{zone, centre.latitude < 0});
+}
+Envelope envelope_to_wgs84(const Envelope &gk, double tolerance) {
+    return transform_envelope<WGS84>(gauss_kruger_corner(gk.min_x, gk.min_y),
+                                     gauss_kruger_corner(gk.max_x, gk.min_y),
+                                     gauss_kruger_corner(gk.max_x, gk.max_y),
+                                     gauss_kruger_corner(gk.min_x, gk.max_y), tolerance,
+                                     project<WGS84, GaussKruger>);
+}
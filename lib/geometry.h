@@ -0,0 +1,46 @@
+#ifndef TRANSFORMATION_LIB_GEOMETRY_H_
+#define TRANSFORMATION_LIB_GEOMETRY_H_
+
+#include "transformations.h"
+
+#include <cstddef>
+#include <vector>
+
+// Line strings and polygon rings stored as one vertex array. Part i spans
+// vertices [offsets[i], offsets[i + 1]); a polygon is a run of ring parts.
+template <class Point>
+struct Geometry {
+    std::vector<Point> vertices;
+    std::vector<std::size_t> offsets;
+};
+
+// Project a geometry, densifying edges: wherever the projected midpoint of a
+// source segment is more than `tolerance` metres off the straight projected
+// segment, the midpoint is inserted and both halves are checked again.
+// Identical input vertices (ring closures, shared boundaries) are projected
+// once; the parts of large geometries are densified on the shared thread
+// pool. Geodetic edges take the short way round, also across the
+// antimeridian. The geometry should lie within one projection zone. For
+// to_wgs84() the tolerance is in degrees.
+Geometry<GaussKruger> to_gauss_kruger(const Geometry<WGS84> &geometry, double tolerance);
+Geometry<UTM> to_utm(const Geometry<WGS84> &geometry, double tolerance);
+Geometry<WGS84> to_wgs84(const Geometry<GaussKruger> &geometry, double tolerance);
+
+// Axis-aligned box. Geodetic boxes hold longitude in x and latitude in y
+// (degrees); Gauss-Kruger boxes use GaussKruger::x and GaussKruger::y; UTM
+// boxes hold easting in x and northing in y.
+struct Envelope {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+};
+
+// Reprojects a box by densifying its edges to `tolerance` (metres, or degrees
+// for envelope_to_wgs84) and bounding the result. The returned box is grown
+// by the tolerance so it contains the true image of the input box.
+Envelope envelope_to_gauss_kruger(const Envelope &geodetic, double tolerance);
+Envelope envelope_to_utm(const Envelope &geodetic, double tolerance);
+Envelope envelope_to_wgs84(const Envelope &gk, double tolerance);
+
+#endif  // TRANSFORMATION_LIB_GEOMETRY_H_
@@ -0,0 +1,139 @@
+#include "helmert.h"
+
+#include "stats.h"
+
+#include <cstddef>
+#include <stdexcept>
+
+namespace {
+
+constexpr double radians_per_milliarcsecond = radians_per_degree / 3600e3;
+
+WGS84 apply(const Helmert::Matrix &matrix, const PZ90 &pz_90) {
+    return WGS84{matrix.apply(ECEF{pz_90})};
+}
+PZ90 apply(const Helmert::Matrix &matrix, const WGS84 &wgs_84) {
+    return PZ90{matrix.apply(ECEF{wgs_84})};
+}
+
+template <class Out, class In, class MatrixAt>
+std::vector<Out> convert(const std::vector<In> &points, const std::vector<double> &epochs, MatrixAt matrix_at) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_HELMERT, points.size());
+    if (epochs.size() != points.size()) {
+        throw std::invalid_argument("Helmert: one epoch per point expected");
+    }
+    std::vector<Out> result;
+    result.reserve(points.size());
+    if (points.empty()) {
+        return result;
+    }
+    double epoch = epochs[0];
+    Helmert::Matrix matrix = matrix_at(epoch);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        if (epochs[i] != epoch) {
+            epoch = epochs[i];
+            matrix = matrix_at(epoch);
+        }
+        result.push_back(apply(matrix, points[i]));
+    }
+    return result;
+}
+
+}  // namespace
+
+Helmert::Helmert(HelmertParams parameters, HelmertParams rates, double reference_epoch)
+    : _parameters(parameters), _rates(rates), _reference_epoch(reference_epoch) {}
+
+ECEF Helmert::Matrix::apply(const ECEF &point) const {
+    return ECEF{t[0] + r[0][0] * point.x + r[0][1] * point.y + r[0][2] * point.z,
+                t[1] + r[1][0] * point.x + r[1][1] * point.y + r[1][2] * point.z,
+                t[2] + r[2][0] * point.x + r[2][1] * point.y + r[2][2] * point.z};
+}
+
+Helmert::Matrix Helmert::Matrix::inverse() const {
+    Matrix result;
+    result.r[0][0] = r[1][1] * r[2][2] - r[1][2] * r[2][1];
+    result.r[0][1] = r[0][2] * r[2][1] - r[0][1] * r[2][2];
+    result.r[0][2] = r[0][1] * r[1][2] - r[0][2] * r[1][1];
+    result.r[1][0] = r[1][2] * r[2][0] - r[1][0] * r[2][2];
+    result.r[1][1] = r[0][0] * r[2][2] - r[0][2] * r[2][0];
+    result.r[1][2] = r[0][2] * r[1][0] - r[0][0] * r[1][2];
+    result.r[2][0] = r[1][0] * r[2][1] - r[1][1] * r[2][0];
+    result.r[2][1] = r[0][1] * r[2][0] - r[0][0] * r[2][1];
+    result.r[2][2] = r[0][0] * r[1][1] - r[0][1] * r[1][0];
+    double determinant = r[0][0] * result.r[0][0] + r[0][1] * result.r[1][0] + r[0][2] * result.r[2][0];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            result.r[i][j] /= determinant;
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        result.t[i] = -(result.r[i][0] * t[0] + result.r[i][1] * t[1] + result.r[i][2] * t[2]);
+    }
+    return result;
+}
+
+Helmert::Matrix Helmert::at(double epoch) const {
+    double dt = epoch - _reference_epoch;
+    double m = 1 + (_parameters.s + _rates.s * dt) * 1e-9;
+    double rx = (_parameters.rx + _rates.rx * dt) * radians_per_milliarcsecond;
+    double ry = (_parameters.ry + _rates.ry * dt) * radians_per_milliarcsecond;
+    double rz = (_parameters.rz + _rates.rz * dt) * radians_per_milliarcsecond;
+
+    Matrix matrix;
+    matrix.t[0] = _parameters.tx + _rates.tx * dt;
+    matrix.t[1] = _parameters.ty + _rates.ty * dt;
+    matrix.t[2] = _parameters.tz + _rates.tz * dt;
+    matrix.r[0][0] = m;
+    matrix.r[0][1] = -m * rz;
+    matrix.r[0][2] = m * ry;
+    matrix.r[1][0] = m * rz;
+    matrix.r[1][1] = m;
+    matrix.r[1][2] = -m * rx;
+    matrix.r[2][0] = -m * ry;
+    matrix.r[2][1] = m * rx;
+    matrix.r[2][2] = m;
+    return matrix;
+}
+
+ECEF Helmert::transform(const ECEF &point, double epoch) const {
+    TRANSFORMATIONS_COUNTED(ROUTE::HELMERT);
+    return at(epoch).apply(point);
+}
+
+WGS84 Helmert::to_wgs84(const PZ90 &pz_90, double epoch) const {
+    TRANSFORMATIONS_COUNTED(ROUTE::HELMERT);
+    return apply(at(epoch), pz_90);
+}
+PZ90 Helmert::to_pz90(const WGS84 &wgs_84, double epoch) const {
+    TRANSFORMATIONS_COUNTED(ROUTE::HELMERT);
+    return apply(at(epoch).inverse(), wgs_84);
+}
+
+std::vector<WGS84> Helmert::to_wgs84(const std::vector<PZ90> &pz_90, double epoch) const {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_HELMERT, pz_90.size());
+    Matrix matrix = at(epoch);
+    std::vector<WGS84> result;
+    result.reserve(pz_90.size());
+    for (const PZ90 &point : pz_90) {
+        result.push_back(apply(matrix, point));
+    }
+    return result;
+}
+std::vector<PZ90> Helmert::to_pz90(const std::vector<WGS84> &wgs_84, double epoch) const {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_HELMERT, wgs_84.size());
+    Matrix matrix = at(epoch).inverse();
+    std::vector<PZ90> result;
+    result.reserve(wgs_84.size());
+    for (const WGS84 &point : wgs_84) {
+        result.push_back(apply(matrix, point));
+    }
+    return result;
+}
+
+std::vector<WGS84> Helmert::to_wgs84(const std::vector<PZ90> &pz_90, const std::vector<double> &epochs) const {
+    return convert<WGS84>(pz_90, epochs, [this](double epoch) { return at(epoch); });
+}
+std::vector<PZ90> Helmert::to_pz90(const std::vector<WGS84> &wgs_84, const std::vector<double> &epochs) const {
+    return convert<PZ90>(wgs_84, epochs, [this](double epoch) { return at(epoch).inverse(); });
+}
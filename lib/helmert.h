@@ -0,0 +1,62 @@
+#ifndef TRANSFORMATION_LIB_HELMERT_H_
+#define TRANSFORMATION_LIB_HELMERT_H_
+
+#include "ecef.h"
+#include "transformations.h"
+
+#include <vector>
+
+// Seven Helmert parameters, or their yearly rates.
+struct HelmertParams {
+    double tx;  // metres
+    double ty;
+    double tz;
+    double s;   // parts per billion
+    double rx;  // milliarcseconds
+    double ry;
+    double rz;
+};
+
+// Time-dependent (14-parameter) Helmert transformation between Earth-centred
+// frames: the parameters at `reference_epoch` plus their rates, epochs in
+// decimal years. Rotations follow the IERS position-vector convention,
+//     X' = T + (1 + s) R X,   R = [[1, -rz, ry], [rz, 1, -rx], [-ry, rx, 1]].
+//
+// Set up from PZ90 to WGS84 it replaces the static PZ90::p shift of those
+// routes; the inverse direction uses the exact inverse matrix.
+class Helmert {
+ public:
+    Helmert(HelmertParams parameters, HelmertParams rates, double reference_epoch);
+
+    // The transformation frozen at one epoch. Building it costs a handful of
+    // multiplications, applying it nine.
+    struct Matrix {
+        double t[3];
+        double r[3][3];
+
+        ECEF apply(const ECEF &point) const;
+        Matrix inverse() const;
+    };
+    Matrix at(double epoch) const;
+
+    ECEF transform(const ECEF &point, double epoch) const;
+
+    WGS84 to_wgs84(const PZ90 &pz_90, double epoch) const;
+    PZ90 to_pz90(const WGS84 &wgs_84, double epoch) const;
+
+    // One matrix for the whole batch.
+    std::vector<WGS84> to_wgs84(const std::vector<PZ90> &pz_90, double epoch) const;
+    std::vector<PZ90> to_pz90(const std::vector<WGS84> &wgs_84, double epoch) const;
+    // An epoch per point; runs of equal epochs share one matrix, so archives
+    // sorted by epoch cost little more than a single-epoch batch. Throws
+    // std::invalid_argument unless there is exactly one epoch per point.
+    std::vector<WGS84> to_wgs84(const std::vector<PZ90> &pz_90, const std::vector<double> &epochs) const;
+    std::vector<PZ90> to_pz90(const std::vector<WGS84> &wgs_84, const std::vector<double> &epochs) const;
+
+ private:
+    HelmertParams _parameters;
+    HelmertParams _rates;
+    double _reference_epoch;
+};
+
+#endif  // TRANSFORMATION_LIB_HELMERT_H_
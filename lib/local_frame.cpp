@@ -0,0 +1,120 @@
+#include "local_frame.h"
+
+#include "elementary.h"
+#include "stats.h"
+
+#include <cmath>
+
+namespace {
+
+template <class Out, class In, class Convert>
+std::vector<Out> convert(const std::vector<In> &points, Convert convert_one) {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_LOCAL_FRAME, points.size());
+    std::vector<Out> result;
+    result.reserve(points.size());
+    for (const In &point : points) {
+        result.push_back(convert_one(point));
+    }
+    return result;
+}
+
+}  // namespace
+
+LocalFrame::LocalFrame(WGS84 origin) : _origin(origin) {
+    Radian B = origin.latitude;
+    Radian L = origin.longitude;
+    double sinB = math::sin(B);
+    double cosB = math::cos(B);
+    double sinL = math::sin(L);
+    double cosL = math::cos(L);
+    _r[0][0] = -sinL;
+    _r[0][1] = cosL;
+    _r[0][2] = 0;
+    _r[1][0] = -sinB * cosL;
+    _r[1][1] = -sinB * sinL;
+    _r[1][2] = cosB;
+    _r[2][0] = cosB * cosL;
+    _r[2][1] = cosB * sinL;
+    _r[2][2] = sinB;
+}
+
+ENU LocalFrame::to_enu(const ECEF &ecef) const {
+    TRANSFORMATIONS_COUNTED(ROUTE::LOCAL_FRAME);
+    double dx = ecef.x - _origin.x;
+    double dy = ecef.y - _origin.y;
+    double dz = ecef.z - _origin.z;
+    ENU enu;
+    enu.east = _r[0][0] * dx + _r[0][1] * dy;
+    enu.north = _r[1][0] * dx + _r[1][1] * dy + _r[1][2] * dz;
+    enu.up = _r[2][0] * dx + _r[2][1] * dy + _r[2][2] * dz;
+    return enu;
+}
+
+NED LocalFrame::to_ned(const ECEF &ecef) const {
+    ENU enu = to_enu(ecef);
+    NED ned;
+    ned.north = enu.north;
+    ned.east = enu.east;
+    ned.down = -enu.up;
+    return ned;
+}
+
+ECEF LocalFrame::to_ecef(const ENU &enu) const {
+    TRANSFORMATIONS_COUNTED(ROUTE::LOCAL_FRAME);
+    return ECEF{_origin.x + _r[0][0] * enu.east + _r[1][0] * enu.north + _r[2][0] * enu.up,
+                _origin.y + _r[0][1] * enu.east + _r[1][1] * enu.north + _r[2][1] * enu.up,
+                _origin.z + _r[1][2] * enu.north + _r[2][2] * enu.up};
+}
+
+ECEF LocalFrame::to_ecef(const NED &ned) const {
+    ENU enu;
+    enu.east = ned.east;
+    enu.north = ned.north;
+    enu.up = -ned.down;
+    return to_ecef(enu);
+}
+
+void LocalFrame::to_enu(const double *x, const double *y, const double *z,
+                        double *east, double *north, double *up, std::size_t n) const {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_LOCAL_FRAME, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        double dx = x[i] - _origin.x;
+        double dy = y[i] - _origin.y;
+        double dz = z[i] - _origin.z;
+        east[i] = _r[0][0] * dx + _r[0][1] * dy;
+        north[i] = _r[1][0] * dx + _r[1][1] * dy + _r[1][2] * dz;
+        up[i] = _r[2][0] * dx + _r[2][1] * dy + _r[2][2] * dz;
+    }
+}
+
+void LocalFrame::to_ecef(const double *east, const double *north, const double *up,
+                         double *x, double *y, double *z, std::size_t n) const {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_LOCAL_FRAME, n);
+    for (std::size_t i = 0; i < n; ++i) {
+        double e = east[i];
+        double nn = north[i];
+        double u = up[i];
+        x[i] = _origin.x + _r[0][0] * e + _r[1][0] * nn + _r[2][0] * u;
+        y[i] = _origin.y + _r[0][1] * e + _r[1][1] * nn + _r[2][1] * u;
+        z[i] = _origin.z + _r[1][2] * nn + _r[2][2] * u;
+    }
+}
+
+std::vector<ENU> LocalFrame::to_enu(const std::vector<ECEF> &ecef) const {
+    return convert<ENU>(ecef, [this](const ECEF &point) { return to_enu(point); });
+}
+std::vector<NED> LocalFrame::to_ned(const std::vector<ECEF> &ecef) const {
+    return convert<NED>(ecef, [this](const ECEF &point) { return to_ned(point); });
+}
+std::vector<ECEF> LocalFrame::to_ecef(const std::vector<ENU> &enu) const {
+    return convert<ECEF>(enu, [this](const ENU &point) { return to_ecef(point); });
+}
+std::vector<ECEF> LocalFrame::to_ecef(const std::vector<NED> &ned) const {
+    return convert<ECEF>(ned, [this](const NED &point) { return to_ecef(point); });
+}
+std::vector<ENU> LocalFrame::to_enu(const std::vector<WGS84> &wgs_84) const {
+    return convert<ENU>(wgs_84, [this](const WGS84 &point) { return to_enu(point); });
+}
+std::vector<WGS84> LocalFrame::to_wgs84(const std::vector<ENU> &enu) const {
+    return convert<WGS84>(enu, [this](const ENU &point) { return to_wgs84(point); });
+}
@@ -0,0 +1,63 @@
+#ifndef TRANSFORMATION_LIB_LOCAL_FRAME_H_
+#define TRANSFORMATION_LIB_LOCAL_FRAME_H_
+
+#include "ecef.h"
+#include "transformations.h"
+
+#include <cstddef>
+#include <vector>
+
+// Local tangent plane coordinates in metres around a reference point.
+class ENU {
+ public:
+    double east{};
+    double north{};
+    double up{};
+};
+
+class NED {
+ public:
+    double north{};
+    double east{};
+    double down{};
+};
+
+// Tangent plane at a reference point. The origin's ECEF position and the
+// rotation into the plane are computed once, so a conversion costs one
+// subtraction and a 3x3 product per point (plus the geodetic <-> ECEF step
+// for the WGS84 overloads).
+class LocalFrame {
+ public:
+    explicit LocalFrame(WGS84 origin);
+
+    ENU to_enu(const ECEF &ecef) const;
+    NED to_ned(const ECEF &ecef) const;
+    ECEF to_ecef(const ENU &enu) const;
+    ECEF to_ecef(const NED &ned) const;
+
+    ENU to_enu(const WGS84 &wgs_84) const { return to_enu(ECEF{wgs_84}); }
+    NED to_ned(const WGS84 &wgs_84) const { return to_ned(ECEF{wgs_84}); }
+    WGS84 to_wgs84(const ENU &enu) const { return WGS84{to_ecef(enu)}; }
+    WGS84 to_wgs84(const NED &ned) const { return WGS84{to_ecef(ned)}; }
+
+    // Column kernels, written branch-free so the compiler vectorises them.
+    // Outputs may alias the inputs.
+    void to_enu(const double *x, const double *y, const double *z,
+                double *east, double *north, double *up, std::size_t n) const;
+    void to_ecef(const double *east, const double *north, const double *up,
+                 double *x, double *y, double *z, std::size_t n) const;
+
+    std::vector<ENU> to_enu(const std::vector<ECEF> &ecef) const;
+    std::vector<NED> to_ned(const std::vector<ECEF> &ecef) const;
+    std::vector<ECEF> to_ecef(const std::vector<ENU> &enu) const;
+    std::vector<ECEF> to_ecef(const std::vector<NED> &ned) const;
+    std::vector<ENU> to_enu(const std::vector<WGS84> &wgs_84) const;
+    std::vector<WGS84> to_wgs84(const std::vector<ENU> &enu) const;
+
+ private:
+    ECEF _origin;
+    // Rows are the east, north and up unit vectors in ECEF.
+    double _r[3][3];
+};
+
+#endif  // TRANSFORMATION_LIB_LOCAL_FRAME_H_
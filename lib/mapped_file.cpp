@@ -0,0 +1,31 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string &path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return;
+    }
+    void *data = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return;
+    }
+    _data = data;
+    _size = static_cast<std::size_t>(info.st_size);
+}
+
+MappedFile::~MappedFile() {
+    if (_data) {
+        munmap(_data, _size);
+    }
+}
@@ -0,0 +1,24 @@
+#ifndef TRANSFORMATION_LIB_MAPPED_FILE_H_
+#define TRANSFORMATION_LIB_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+// Read-only memory mapping of a whole file; data() is nullptr if the file
+// could not be opened or mapped.
+class MappedFile {
+ public:
+    explicit MappedFile(const std::string &path);
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    const char *data() const { return static_cast<const char *>(_data); }
+    std::size_t size() const { return _size; }
+
+ private:
+    void *_data = nullptr;
+    std::size_t _size = 0;
+};
+
+#endif  // TRANSFORMATION_LIB_MAPPED_FILE_H_
@@ -0,0 +1,197 @@
+#include "ntv2.h"
+
+#include "stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+constexpr std::size_t record_size = 16;
+constexpr std::size_t header_records = 11;
+constexpr int max_iterations = 4;
+
+std::string key(const char *record) {
+    std::string text(record, 8);
+    text.erase(text.find_last_not_of(" \0", std::string::npos, 2) + 1);
+    return text;
+}
+
+template <class T>
+T read(const char *bytes, bool swap) {
+    char buffer[sizeof(T)];
+    std::memcpy(buffer, bytes, sizeof(T));
+    if (swap) {
+        std::reverse(buffer, buffer + sizeof(T));
+    }
+    T value;
+    std::memcpy(&value, buffer, sizeof(T));
+    return value;
+}
+
+}  // namespace
+
+NTv2Grid::NTv2Grid(const std::string &path) : _file(path) {
+    const char *bytes = _file.data();
+    std::size_t size = _file.size();
+    if (!bytes || size < header_records * record_size || key(bytes) != "NUM_OREC") {
+        return;
+    }
+    std::int32_t overview_records = read<std::int32_t>(bytes + 8, false);
+    if (overview_records != static_cast<std::int32_t>(header_records)) {
+        _swap = true;
+        overview_records = read<std::int32_t>(bytes + 8, true);
+        if (overview_records != static_cast<std::int32_t>(header_records)) {
+            return;
+        }
+    }
+    std::int32_t file_count = read<std::int32_t>(bytes + 2 * record_size + 8, _swap);
+
+    std::vector<SubGrid> grids;
+    std::size_t offset = header_records * record_size;
+    for (std::int32_t f = 0; f < file_count; ++f) {
+        if (offset + header_records * record_size > size) {
+            return;
+        }
+        const char *header = bytes + offset;
+        SubGrid grid{};
+        grid.name = std::string(header + 8, 8);
+        grid.parent = std::string(header + record_size + 8, 8);
+        double values[6];
+        for (int i = 0; i < 6; ++i) {
+            values[i] = read<double>(header + (4 + i) * record_size + 8, _swap);
+        }
+        grid.south = values[0];
+        grid.north = values[1];
+        grid.east = values[2];
+        grid.west = values[3];
+        grid.step_latitude = values[4];
+        grid.step_longitude = values[5];
+        std::int32_t count = read<std::int32_t>(header + 10 * record_size + 8, _swap);
+        // Interpolation needs at least a 2x2 block of nodes.
+        if (!(grid.step_latitude > 0) || !(grid.step_longitude > 0) || count <= 0 ||
+            !(grid.north - grid.south >= grid.step_latitude) || !(grid.west - grid.east >= grid.step_longitude) ||
+            !std::isfinite(grid.north - grid.south) || !std::isfinite(grid.west - grid.east)) {
+            return;
+        }
+        grid.rows = static_cast<std::size_t>(std::lround((grid.north - grid.south) / grid.step_latitude)) + 1;
+        grid.columns = static_cast<std::size_t>(std::lround((grid.west - grid.east) / grid.step_longitude)) + 1;
+        offset += header_records * record_size;
+        if (grid.rows < 2 || grid.columns < 2 || grid.rows * grid.columns != static_cast<std::size_t>(count) || offset + count * record_size > size) {
+            return;
+        }
+        grid.nodes = bytes + offset;
+        offset += count * record_size;
+        grids.push_back(grid);
+    }
+
+    for (std::size_t i = 0; i < grids.size(); ++i) {
+        std::string parent = key(grids[i].parent.c_str());
+        auto found = std::find_if(grids.begin(), grids.end(),
+                                  [&](const SubGrid &grid) { return key(grid.name.c_str()) == parent; });
+        if (parent == "NONE" || found == grids.end()) {
+            _roots.push_back(i);
+        } else {
+            found->children.push_back(i);
+        }
+    }
+    _grids.swap(grids);
+}
+
+const NTv2Grid::SubGrid *NTv2Grid::find(double latitude_seconds, double west_seconds) const {
+    auto contains = [&](const SubGrid &grid) {
+        return latitude_seconds >= grid.south && latitude_seconds <= grid.north &&
+               west_seconds >= grid.east && west_seconds <= grid.west;
+    };
+    const std::vector<std::size_t> *candidates = &_roots;
+    const SubGrid *best = nullptr;
+    // Descend into the densest sub-grid that still contains the point.
+    while (true) {
+        auto found = std::find_if(candidates->begin(), candidates->end(),
+                                  [&](std::size_t i) { return contains(_grids[i]); });
+        if (found == candidates->end()) {
+            return best;
+        }
+        best = &_grids[*found];
+        candidates = &best->children;
+    }
+}
+
+float NTv2Grid::node_value(const SubGrid &grid, std::size_t index, int field) const {
+    return read<float>(grid.nodes + index * record_size + field * sizeof(float), _swap);
+}
+
+bool NTv2Grid::shift(Degree latitude, Degree longitude, double &dB, double &dL) const {
+    double latitude_seconds = latitude * 3600;
+    double west_seconds = -longitude * 3600;
+    const SubGrid *grid = find(latitude_seconds, west_seconds);
+    if (!grid) {
+        return false;
+    }
+    double y = (latitude_seconds - grid->south) / grid->step_latitude;
+    double x = (west_seconds - grid->east) / grid->step_longitude;
+    std::size_t row = std::min(static_cast<std::size_t>(y), grid->rows - 2);
+    std::size_t column = std::min(static_cast<std::size_t>(x), grid->columns - 2);
+    double ty = y - static_cast<double>(row);
+    double tx = x - static_cast<double>(column);
+
+    std::size_t i00 = row * grid->columns + column;
+    std::size_t i10 = i00 + grid->columns;
+    double shifts[2];
+    for (int field = 0; field < 2; ++field) {
+        double v00 = node_value(*grid, i00, field);
+        double v01 = node_value(*grid, i00 + 1, field);
+        double v10 = node_value(*grid, i10, field);
+        double v11 = node_value(*grid, i10 + 1, field);
+        shifts[field] = (v00 * (1 - tx) + v01 * tx) * (1 - ty) + (v10 * (1 - tx) + v11 * tx) * ty;
+    }
+    dB = shifts[0];
+    // NTv2 longitude shifts are positive west.
+    dL = -shifts[1];
+    return true;
+}
+
+WGS84 NTv2Grid::to_wgs84(const SK42 &sk_42) const {
+    TRANSFORMATIONS_COUNTED(ROUTE::NTV2);
+    double dB = std::numeric_limits<double>::quiet_NaN();
+    double dL = dB;
+    shift(sk_42.latitude, sk_42.longitude, dB, dL);
+    return WGS84{Degree{sk_42.latitude + dB / 3600}, Degree{sk_42.longitude + dL / 3600}, sk_42.altitude};
+}
+
+SK42 NTv2Grid::to_sk42(const WGS84 &wgs_84) const {
+    TRANSFORMATIONS_COUNTED(ROUTE::NTV2);
+    double latitude = wgs_84.latitude;
+    double longitude = wgs_84.longitude;
+    for (int i = 0; i < max_iterations; ++i) {
+        double dB = std::numeric_limits<double>::quiet_NaN();
+        double dL = dB;
+        shift(Degree{latitude}, Degree{longitude}, dB, dL);
+        latitude = wgs_84.latitude - dB / 3600;
+        longitude = wgs_84.longitude - dL / 3600;
+    }
+    return SK42{Degree{latitude}, Degree{longitude}, wgs_84.altitude};
+}
+
+std::vector<WGS84> NTv2Grid::to_wgs84(const std::vector<SK42> &sk_42) const {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_NTV2, sk_42.size());
+    std::vector<WGS84> result;
+    result.reserve(sk_42.size());
+    for (const SK42 &point : sk_42) {
+        result.push_back(to_wgs84(point));
+    }
+    return result;
+}
+
+std::vector<SK42> NTv2Grid::to_sk42(const std::vector<WGS84> &wgs_84) const {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_NTV2, wgs_84.size());
+    std::vector<SK42> result;
+    result.reserve(wgs_84.size());
+    for (const WGS84 &point : wgs_84) {
+        result.push_back(to_sk42(point));
+    }
+    return result;
+}
@@ -0,0 +1,56 @@
+#ifndef TRANSFORMATION_LIB_NTV2_H_
+#define TRANSFORMATION_LIB_NTV2_H_
+
+#include "mapped_file.h"
+#include "transformations.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Datum shift grid in NTv2 format, memory-mapped. Both byte orders are
+// accepted. Sub-grids are indexed by parent, and a point uses the densest
+// sub-grid that contains it. Inside a sub-grid the cell is found by
+// arithmetic, and its four nodes are interpolated bilinearly.
+//
+// A grid published for SK42 -> WGS84 replaces the Molodensky stage
+// (Geo::dB/dL with SK42::p) of those routes. Heights are passed through.
+class NTv2Grid {
+ public:
+    explicit NTv2Grid(const std::string &path);
+
+    bool valid() const { return !_grids.empty(); }
+
+    // Shift in arc seconds, positive north and east, the same units Geo::dB
+    // and Geo::dL return. False outside every sub-grid.
+    bool shift(Degree latitude, Degree longitude, double &dB, double &dL) const;
+
+    // Forward shift, the drop-in for WGS84(SK42). Points outside the grid get NaN.
+    WGS84 to_wgs84(const SK42 &sk_42) const;
+    // Inverse shift, found by iterating the forward one, the drop-in for SK42(WGS84).
+    SK42 to_sk42(const WGS84 &wgs_84) const;
+
+    std::vector<WGS84> to_wgs84(const std::vector<SK42> &sk_42) const;
+    std::vector<SK42> to_sk42(const std::vector<WGS84> &wgs_84) const;
+
+ private:
+    struct SubGrid {
+        std::string name;
+        std::string parent;
+        // Bounds and steps in arc seconds, longitude positive west as in NTv2.
+        double south, north, east, west, step_latitude, step_longitude;
+        std::size_t rows, columns;
+        const char *nodes;  // rows * columns records of four float32
+        std::vector<std::size_t> children;
+    };
+
+    const SubGrid *find(double latitude_seconds, double west_seconds) const;
+    float node_value(const SubGrid &grid, std::size_t index, int field) const;
+
+    MappedFile _file;
+    bool _swap = false;
+    std::vector<SubGrid> _grids;
+    std::vector<std::size_t> _roots;
+};
+
+#endif  // TRANSFORMATION_LIB_NTV2_H_
@@ -5,17 +5,118 @@
 #include "radian_degree.h"
 
 #include <cmath>
+#include <cstdio>
+#include <cstdlib>
 
-Degree::Degree(Radian radian) {
-    _degree = radian * 180 / M_PI;
+void degrees_to_radians(const double *in, double *out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = in[i] * radians_per_degree;
+    }
 }
-Degree::operator double() const {
-    return _degree;
+void radians_to_degrees(const double *in, double *out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = in[i] * degrees_per_radian;
+    }
 }
 
-Radian::Radian(Degree degree) {
-    _radian = degree * M_PI / 180;
+namespace {
+
+// Length of the separator starting at `p`, or 0 if there is none.
+std::size_t separator(const char *p) {
+    if (*p == ' ' || *p == '\t' || *p == ':' || *p == '\'' || *p == '"') {
+        return 1;
+    }
+    return p[0] == '\xc2' && p[1] == '\xb0' ? 2 : 0;
+}
+
+bool is_hemisphere(char c) {
+    return c == 'N' || c == 'n' || c == 'S' || c == 's' || c == 'E' || c == 'e' || c == 'W' || c == 'w';
 }
-Radian::operator double() const {
-    return _radian;
+
+// Length of the unsigned decimal number starting at `p`: digits with at most
+// one point, and at least one digit.
+std::size_t number_length(const char *p) {
+    std::size_t length = 0;
+    bool digits = false;
+    bool point = false;
+    for (;; ++length) {
+        if (p[length] >= '0' && p[length] <= '9') {
+            digits = true;
+        } else if (p[length] == '.' && !point) {
+            point = true;
+        } else {
+            break;
+        }
+    }
+    return digits ? length : 0;
+}
+
+}  // namespace
+
+bool parse_dms(const std::string &text, double &degrees) {
+    double parts[3] = {};
+    int count = 0;
+    bool negative = false;
+    bool sign = false;
+    bool hemisphere = false;
+    const char *p = text.c_str();
+    while (*p == ' ' || *p == '\t') {
+        ++p;
+    }
+    if (*p == '-' || *p == '+') {
+        negative = *p == '-';
+        sign = true;
+        ++p;
+    }
+    while (*p) {
+        if (std::size_t length = separator(p)) {
+            p += length;
+        } else if (std::size_t length = number_length(p)) {
+            if (count == 3 || hemisphere) {
+                return false;
+            }
+            char *end = nullptr;
+            parts[count++] = std::strtod(p, &end);
+            p += length;
+            // Rejects exponents and numbers run together, such as "1e5" or "5.5.5".
+            if (end != p || (*p && !separator(p) && !is_hemisphere(*p))) {
+                return false;
+            }
+        } else if (is_hemisphere(*p) && count > 0 && !hemisphere && !sign) {
+            hemisphere = true;
+            negative = *p == 'S' || *p == 's' || *p == 'W' || *p == 'w';
+            ++p;
+        } else {
+            return false;
+        }
+    }
+    if (count == 0 || parts[0] >= 360 || parts[1] >= 60 || parts[2] >= 60) {
+        return false;
+    }
+    degrees = parts[0] + parts[1] / 60 + parts[2] / 3600;
+    if (negative) {
+        degrees = -degrees;
+    }
+    return true;
+}
+bool parse_dms(const std::string *text, double *degrees, std::size_t n) {
+    bool ok = true;
+    for (std::size_t i = 0; i < n; ++i) {
+        ok &= parse_dms(text[i], degrees[i]);
+    }
+    return ok;
+}
+
+std::string format_dms(double degrees, int precision) {
+    double scale = std::pow(10, precision);
+    // Round once in units of the last printed digit so 59.9995" carries over.
+    long long units = std::llround(std::fabs(degrees) * 3600 * scale);
+    long long per_minute = static_cast<long long>(60 * scale);
+    long long d = units / (60 * per_minute);
+    long long m = units / per_minute % 60;
+    double s = static_cast<double>(units % per_minute) / scale;
+
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%s%lld\xc2\xb0%lld'%.*f\"", degrees < 0 ? "-" : "", d, m, precision, s);
+    return buffer;
 }
@@ -5,16 +5,23 @@
 #ifndef MAIN_LIB_RADIAN_DEGREE_H_
 #define MAIN_LIB_RADIAN_DEGREE_H_
 
+#include <cstddef>
+#include <string>
+
 class Degree;
 class Radian;
 
+constexpr double pi = 3.14159265358979323846;
+constexpr double degrees_per_radian = 180 / pi;
+constexpr double radians_per_degree = pi / 180;
+
 class Degree {
  public:
     Degree() = default;
-    explicit Degree(int degree) : _degree(degree) {}
-    explicit Degree(double degree) : _degree(degree) {}
-    Degree(Radian radian);
-    operator double() const;
+    constexpr explicit Degree(int degree) : _degree(degree) {}
+    constexpr explicit Degree(double degree) : _degree(degree) {}
+    constexpr Degree(Radian radian);
+    constexpr operator double() const { return _degree; }
 
  private:
     double _degree;
@@ -23,13 +30,28 @@ class Degree {
 class Radian {
  public:
     Radian() = default;
-    explicit Radian(double radian) : _radian(radian) {}
-    Radian(Degree degree);
-    operator double() const;
+    constexpr explicit Radian(double radian) : _radian(radian) {}
+    constexpr Radian(Degree degree) : _radian(degree * radians_per_degree) {}
+    constexpr operator double() const { return _radian; }
 
  private:
     double _radian;
 };
 
+constexpr Degree::Degree(Radian radian) : _degree(radian * degrees_per_radian) {}
+
+// Array versions of the conversions above; `in` and `out` may alias.
+void degrees_to_radians(const double *in, double *out, std::size_t n);
+void radians_to_degrees(const double *in, double *out, std::size_t n);
+
+// Parses angles such as "55 45 30.5", "55°45'30.5\"N" or "-37:36:59": up to
+// three unsigned decimal numbers separated by spaces, ':', '°', ' or ", with
+// degrees below 360 and minutes and seconds below 60. Either a leading sign
+// or a hemisphere letter after the numbers may be given; S or W, or a minus,
+// makes the angle negative. Any other character fails the parse.
+bool parse_dms(const std::string &text, double &degrees);
+bool parse_dms(const std::string *text, double *degrees, std::size_t n);
+// Formats as D°M'S.S" with `precision` decimals of seconds and a sign.
+std::string format_dms(double degrees, int precision = 3);
 
 #endif  // MAIN_LIB_RADIAN_DEGREE_H_
@@ -0,0 +1,219 @@
+#include "route.h"
+
+#include "ecef.h"
+#include "stats.h"
+
+#include <algorithm>
+#include <deque>
+
+namespace {
+
+constexpr std::size_t crs_count = 6;
+constexpr std::size_t block_size = 256;
+
+template <class Point>
+Point load(const CoordinateColumns &c, std::size_t i);
+template <>
+WGS84 load(const CoordinateColumns &c, std::size_t i) {
+    return WGS84{Degree{c.values[0][i]}, Degree{c.values[1][i]}, c.values[2][i]};
+}
+template <>
+PZ90 load(const CoordinateColumns &c, std::size_t i) {
+    return PZ90{Degree{c.values[0][i]}, Degree{c.values[1][i]}, c.values[2][i]};
+}
+template <>
+SK42 load(const CoordinateColumns &c, std::size_t i) {
+    return SK42{Degree{c.values[0][i]}, Degree{c.values[1][i]}, c.values[2][i]};
+}
+template <>
+GaussKruger load(const CoordinateColumns &c, std::size_t i) {
+    GaussKruger gk;
+    gk.x = c.values[0][i];
+    gk.y = c.values[1][i];
+    gk.height = c.values[2][i];
+    return gk;
+}
+template <>
+ECEF load(const CoordinateColumns &c, std::size_t i) {
+    return ECEF{c.values[0][i], c.values[1][i], c.values[2][i]};
+}
+
+void clear_zone(const CoordinateColumns &c, std::size_t i) {
+    if (c.zone_number) {
+        c.zone_number[i] = 0;
+        c.zone_letter[i] = '\0';
+    }
+}
+
+template <class Point>
+void store(const CoordinateColumns &c, std::size_t i, const Point &point) {
+    c.values[0][i] = point.latitude;
+    c.values[1][i] = point.longitude;
+    c.values[2][i] = point.altitude;
+    clear_zone(c, i);
+}
+void store(const CoordinateColumns &c, std::size_t i, const GaussKruger &gk) {
+    c.values[0][i] = gk.x;
+    c.values[1][i] = gk.y;
+    c.values[2][i] = gk.height;
+    clear_zone(c, i);
+}
+void store(const CoordinateColumns &c, std::size_t i, const ECEF &ecef) {
+    c.values[0][i] = ecef.x;
+    c.values[1][i] = ecef.y;
+    c.values[2][i] = ecef.z;
+    clear_zone(c, i);
+}
+
+template <class Out, class In>
+void stage(const CoordinateColumns &columns, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        store(columns, i, Out{load<In>(columns, i)});
+    }
+}
+
+// UTM goes through the numeric zone form, so no stage builds a zone string.
+void utm_from_wgs84(const CoordinateColumns &columns, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        int number = 0;
+        char letter = 0;
+        UTM::project(load<WGS84>(columns, i), columns.values[0][i], columns.values[1][i], number, letter);
+        columns.zone_number[i] = number;
+        columns.zone_letter[i] = letter;
+    }
+}
+void wgs84_from_utm(const CoordinateColumns &columns, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        store(columns, i, UTM::unproject(columns.values[0][i], columns.values[1][i], columns.values[2][i],
+                                         columns.zone_number[i], columns.zone_letter[i]));
+    }
+}
+
+struct Edge {
+    CRS from;
+    CRS to;
+    Route::Stage stage;
+};
+
+// Every stage the library implements. Listed in order of preference: among
+// chains of equal length the planner takes the one using earlier edges.
+const Edge edges[] = {
+    {CRS::WGS84, CRS::SK42, stage<SK42, WGS84>},
+    {CRS::SK42, CRS::WGS84, stage<WGS84, SK42>},
+    {CRS::PZ90, CRS::WGS84, stage<WGS84, PZ90>},
+    {CRS::WGS84, CRS::PZ90, stage<PZ90, WGS84>},
+    {CRS::SK42, CRS::GAUSS_KRUGER, stage<GaussKruger, SK42>},
+    {CRS::GAUSS_KRUGER, CRS::SK42, stage<SK42, GaussKruger>},
+    {CRS::WGS84, CRS::UTM, utm_from_wgs84},
+    {CRS::UTM, CRS::WGS84, wgs84_from_utm},
+    {CRS::WGS84, CRS::ECEF, stage<ECEF, WGS84>},
+    {CRS::ECEF, CRS::WGS84, stage<WGS84, ECEF>},
+};
+
+std::size_t crs_index(CRS crs) {
+    return static_cast<std::size_t>(crs);
+}
+
+}  // namespace
+
+class RoutePlanner {
+ public:
+    // Breadth-first search over the edges, then the chain is copied into
+    // the route as a plain list of stage pointers.
+    static Route plan(CRS from, CRS to) {
+        const Edge *reached_by[crs_count] = {};
+        bool seen[crs_count] = {};
+        std::deque<CRS> queue{from};
+        seen[crs_index(from)] = true;
+        while (!queue.empty() && !seen[crs_index(to)]) {
+            CRS current = queue.front();
+            queue.pop_front();
+            for (const Edge &edge : edges) {
+                if (edge.from == current && !seen[crs_index(edge.to)]) {
+                    seen[crs_index(edge.to)] = true;
+                    reached_by[crs_index(edge.to)] = &edge;
+                    queue.push_back(edge.to);
+                }
+            }
+        }
+
+        Route route;
+        route._valid = seen[crs_index(to)];
+        if (!route._valid) {
+            return route;
+        }
+        route._path.push_back(to);
+        for (CRS crs = to; crs != from; crs = reached_by[crs_index(crs)]->from) {
+            route._stages.push_back(reached_by[crs_index(crs)]->stage);
+            route._path.push_back(reached_by[crs_index(crs)]->from);
+        }
+        std::reverse(route._stages.begin(), route._stages.end());
+        std::reverse(route._path.begin(), route._path.end());
+        return route;
+    }
+
+    static std::vector<Route> plan_all() {
+        std::vector<Route> routes;
+        for (std::size_t from = 0; from < crs_count; ++from) {
+            for (std::size_t to = 0; to < crs_count; ++to) {
+                routes.push_back(plan(static_cast<CRS>(from), static_cast<CRS>(to)));
+            }
+        }
+        return routes;
+    }
+};
+
+void Route::operator()(const CoordinateColumns &columns, std::size_t n) const {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_ROUTE, n);
+    for (std::size_t begin = 0; begin < n; begin += block_size) {
+        std::size_t count = std::min(block_size, n - begin);
+        CoordinateColumns block{{columns.values[0] + begin, columns.values[1] + begin, columns.values[2] + begin},
+                                columns.zone_number ? columns.zone_number + begin : nullptr,
+                                columns.zone_letter ? columns.zone_letter + begin : nullptr};
+        for (Stage stage : _stages) {
+            stage(block, count);
+        }
+    }
+}
+
+void Route::operator()(Coordinates *points, std::size_t n) const {
+    TRANSFORMATIONS_TIMED(ROUTE::BATCH_ROUTE, n);
+    // Each block is copied into columns on the stack, converted by every
+    // stage and copied back.
+    double values[3][block_size];
+    std::int32_t zone_number[block_size];
+    char zone_letter[block_size];
+    CoordinateColumns block{{values[0], values[1], values[2]}, zone_number, zone_letter};
+    for (std::size_t begin = 0; begin < n; begin += block_size) {
+        std::size_t count = std::min(block_size, n - begin);
+        Coordinates *chunk = points + begin;
+        for (std::size_t i = 0; i < count; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                values[k][i] = chunk[i].values[k];
+            }
+            zone_number[i] = chunk[i].zone_number;
+            zone_letter[i] = chunk[i].zone_letter;
+        }
+        for (Stage stage : _stages) {
+            stage(block, count);
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                chunk[i].values[k] = values[k][i];
+            }
+            chunk[i].zone_number = zone_number[i];
+            chunk[i].zone_letter = zone_letter[i];
+        }
+    }
+}
+
+namespace {
+
+// Indexed by from * crs_count + to.
+const std::vector<Route> routes = RoutePlanner::plan_all();
+
+}  // namespace
+
+const Route &route(CRS from, CRS to) {
+    return routes[crs_index(from) * crs_count + crs_index(to)];
+}
@@ -0,0 +1,68 @@
+#ifndef TRANSFORMATION_LIB_ROUTE_H_
+#define TRANSFORMATION_LIB_ROUTE_H_
+
+#include "transformations.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Coordinate reference systems the planner can route between. ECEF is
+// Earth-centred Cartesian on the WGS84 ellipsoid.
+enum class CRS { WGS84, PZ90, SK42, GAUSS_KRUGER, UTM, ECEF };
+
+// A point in any CRS: latitude, longitude, height for geodetic systems;
+// x, y, height for Gauss-Kruger; E, N, altitude plus zone for UTM; x, y, z
+// for ECEF. Angles in degrees, lengths in metres. The UTM zone is a number
+// and a latitude band letter, both zero in other systems.
+struct Coordinates {
+    double values[3];
+    std::int32_t zone_number;
+    char zone_letter;
+};
+
+// The same fields for a batch held as columns, one array per field. The zone
+// columns are only needed when the route starts, ends or passes through UTM.
+struct CoordinateColumns {
+    double *values[3];
+    std::int32_t *zone_number;
+    char *zone_letter;
+};
+
+// A chain of conversion stages compiled into a flat list of kernels over
+// numeric columns. Points are pushed through every stage a block at a time,
+// so a block stays in cache across the whole chain.
+//
+// The planner covers the fixed conversions only. NTv2Grid and Helmert need a
+// grid file or an epoch, which a route shared by every caller of a CRS pair
+// cannot carry; apply them around a route, e.g. NTv2Grid::to_wgs84() in place
+// of the SK42 -> WGS84 stage.
+class Route {
+ public:
+    using Stage = void (*)(const CoordinateColumns &columns, std::size_t n);
+
+    // False if no chain of stages connects the two systems.
+    bool valid() const { return _valid; }
+    // Systems visited, source first and target last.
+    const std::vector<CRS> &path() const { return _path; }
+
+    // Converts in place; a no-op for an invalid route.
+    void operator()(const CoordinateColumns &columns, std::size_t n) const;
+    void operator()(Coordinates *points, std::size_t n) const;
+    void operator()(std::vector<Coordinates> &points) const { (*this)(points.data(), points.size()); }
+
+ private:
+    friend class RoutePlanner;
+
+    bool _valid = false;
+    std::vector<CRS> _path;
+    std::vector<Stage> _stages;
+};
+
+// Shortest chain of stages (datum shifts, projections, Cartesian
+// conversions) from `from` to `to`. Every pair is planned once, while the
+// library is initialised, so this is a plain table lookup; it must not be
+// called from the static initialiser of another translation unit.
+const Route &route(CRS from, CRS to);
+
+#endif  // TRANSFORMATION_LIB_ROUTE_H_
@@ -0,0 +1,148 @@
+#include "spatial_index.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+namespace {
+
+constexpr std::size_t parallel_threshold = 1 << 14;
+
+// Sub-array of the implicit tree together with the axis its median splits.
+// nearest() also records a lower bound on the squared distance from the query
+// to any point of the range.
+struct Range {
+    std::size_t begin;
+    std::size_t end;
+    int axis;
+    double bound;
+};
+
+// Enough levels to give the shared pool's workers and the caller a subtree each.
+int parallel_depth() {
+    std::size_t threads = ThreadPool::shared().workers() + 1;
+    int depth = 0;
+    while ((std::size_t{1} << depth) < threads) {
+        ++depth;
+    }
+    return depth;
+}
+
+}  // namespace
+
+SpatialIndex::SpatialIndex(const std::vector<GaussKruger> &points) {
+    _nodes.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        _nodes.push_back(Node{{points[i].x, points[i].y}, i});
+    }
+    build(0, _nodes.size(), 0, parallel_depth());
+}
+
+SpatialIndex::SpatialIndex(const std::vector<UTM> &points) {
+    _nodes.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        _nodes.push_back(Node{{points[i].E, points[i].N}, i});
+    }
+    build(0, _nodes.size(), 0, parallel_depth());
+}
+
+void SpatialIndex::build(std::size_t begin, std::size_t end, int axis, int parallel_depth) {
+    if (end - begin <= 1) {
+        return;
+    }
+    std::size_t mid = begin + (end - begin) / 2;
+    std::nth_element(_nodes.begin() + begin, _nodes.begin() + mid, _nodes.begin() + end,
+                     [axis](const Node &a, const Node &b) { return a.coordinate[axis] < b.coordinate[axis]; });
+    // The two halves are disjoint, so they can be built on two threads.
+    if (parallel_depth > 0 && end - begin >= parallel_threshold) {
+        ThreadPool::shared().parallel_for(2, 1, [&](std::size_t half, std::size_t) {
+            if (half == 0) {
+                build(begin, mid, 1 - axis, parallel_depth - 1);
+            } else {
+                build(mid + 1, end, 1 - axis, parallel_depth - 1);
+            }
+        });
+    } else {
+        build(begin, mid, 1 - axis, 0);
+        build(mid + 1, end, 1 - axis, 0);
+    }
+}
+
+std::vector<std::size_t> SpatialIndex::nearest(double x, double y, std::size_t k) const {
+    using Candidate = std::pair<double, std::size_t>;  // squared distance, node
+    std::priority_queue<Candidate> best;
+    if (k == 0) {
+        return {};
+    }
+    const double query[2] = {x, y};
+
+    // Depth-first walk visiting the side containing the query first.
+    std::vector<Range> stack{{0, _nodes.size(), 0, 0}};
+    while (!stack.empty()) {
+        Range range = stack.back();
+        stack.pop_back();
+        // The k-th distance may have shrunk since the range was pushed.
+        if (range.begin >= range.end || (best.size() == k && range.bound >= best.top().first)) {
+            continue;
+        }
+        std::size_t mid = range.begin + (range.end - range.begin) / 2;
+        const Node &node = _nodes[mid];
+        double dx = node.coordinate[0] - x;
+        double dy = node.coordinate[1] - y;
+        double distance = dx * dx + dy * dy;
+        if (best.size() < k) {
+            best.emplace(distance, mid);
+        } else if (distance < best.top().first) {
+            best.pop();
+            best.emplace(distance, mid);
+        }
+
+        double split = query[range.axis] - node.coordinate[range.axis];
+        Range low{range.begin, mid, 1 - range.axis, range.bound};
+        Range high{mid + 1, range.end, 1 - range.axis, range.bound};
+        Range near_side = split < 0 ? low : high;
+        Range far_side = split < 0 ? high : low;
+        far_side.bound = std::max(range.bound, split * split);
+        if (best.size() < k || far_side.bound < best.top().first) {
+            stack.push_back(far_side);
+        }
+        stack.push_back(near_side);
+    }
+
+    std::vector<std::size_t> result(best.size());
+    for (std::size_t i = result.size(); i > 0; --i) {
+        result[i - 1] = _nodes[best.top().second].id;
+        best.pop();
+    }
+    return result;
+}
+
+std::vector<std::size_t> SpatialIndex::within(double min_x, double min_y, double max_x, double max_y) const {
+    const double low[2] = {min_x, min_y};
+    const double high[2] = {max_x, max_y};
+    std::vector<std::size_t> result;
+
+    std::vector<Range> stack{{0, _nodes.size(), 0, 0}};
+    while (!stack.empty()) {
+        Range range = stack.back();
+        stack.pop_back();
+        if (range.begin >= range.end) {
+            continue;
+        }
+        std::size_t mid = range.begin + (range.end - range.begin) / 2;
+        const Node &node = _nodes[mid];
+        if (node.coordinate[0] >= min_x && node.coordinate[0] <= max_x &&
+            node.coordinate[1] >= min_y && node.coordinate[1] <= max_y) {
+            result.push_back(node.id);
+        }
+        if (low[range.axis] <= node.coordinate[range.axis]) {
+            stack.push_back(Range{range.begin, mid, 1 - range.axis, 0});
+        }
+        if (high[range.axis] >= node.coordinate[range.axis]) {
+            stack.push_back(Range{mid + 1, range.end, 1 - range.axis, 0});
+        }
+    }
+    return result;
+}
@@ -0,0 +1,36 @@
+#ifndef TRANSFORMATION_LIB_SPATIAL_INDEX_H_
+#define TRANSFORMATION_LIB_SPATIAL_INDEX_H_
+
+#include "transformations.h"
+
+#include <cstddef>
+#include <vector>
+
+// Static k-d tree over planar coordinates, stored implicitly in one array
+// (the median of every range is its root), so queries walk contiguous memory.
+// Results are indices into the vector the index was built from. UTM points
+// are only comparable within one zone.
+class SpatialIndex {
+ public:
+    explicit SpatialIndex(const std::vector<GaussKruger> &points);
+    explicit SpatialIndex(const std::vector<UTM> &points);
+
+    // Indices of the `k` closest points, nearest first.
+    std::vector<std::size_t> nearest(double x, double y, std::size_t k) const;
+    // Indices of the points inside the closed box, in no particular order.
+    std::vector<std::size_t> within(double min_x, double min_y, double max_x, double max_y) const;
+
+    std::size_t size() const { return _nodes.size(); }
+
+ private:
+    struct Node {
+        double coordinate[2];
+        std::size_t id;
+    };
+
+    void build(std::size_t begin, std::size_t end, int axis, int parallel_depth);
+
+    std::vector<Node> _nodes;
+};
+
+#endif  // TRANSFORMATION_LIB_SPATIAL_INDEX_H_
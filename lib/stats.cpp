@@ -0,0 +1,210 @@
+#include "stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t route_count = static_cast<std::size_t>(ROUTE::COUNT);
+
+using Shard = StatsShard;
+
+void add(std::atomic<std::uint64_t> &counter, std::uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void add(Stats::Snapshot &totals, const Shard &shard) {
+    for (std::size_t r = 0; r < route_count; ++r) {
+        const Shard::Route &route = shard.routes[r];
+        totals[r].points += route.points.load(std::memory_order_relaxed);
+        totals[r].timed_calls += route.timed_calls.load(std::memory_order_relaxed);
+        totals[r].total_ns += route.total_ns.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i <= RouteStats::buckets; ++i) {
+            totals[r].histogram[i] += route.histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// Live shards plus the totals of threads that have exited. reset() moves the
+// baseline instead of clearing shards that other threads are writing.
+struct Registry {
+    std::mutex mutex;
+    std::vector<Shard *> shards;
+    Stats::Snapshot retired{};
+    Stats::Snapshot baseline{};
+
+    Stats::Snapshot totals() {
+        Stats::Snapshot totals = retired;
+        for (const Shard *shard : shards) {
+            add(totals, *shard);
+        }
+        return totals;
+    }
+};
+
+// Never destroyed, so threads exiting during static destruction can still
+// retire their shards.
+Registry &registry() {
+    static Registry *instance = new Registry;
+    return *instance;
+}
+
+// Set once the thread's Owner is destroyed: a count made after that, from
+// another thread_local destructor, gets a fresh shard that stays registered.
+thread_local bool owner_destroyed = false;
+
+// Exact decimal seconds, so that a bucket bound is not rounded below the
+// durations it counts.
+std::string seconds(std::uint64_t ns) {
+    std::string fraction = std::to_string(1000000000 + ns % 1000000000).substr(1);
+    fraction.erase(fraction.find_last_not_of('0') + 1);
+    return std::to_string(ns / 1000000000) + (fraction.empty() ? "" : "." + fraction);
+}
+
+std::size_t bucket(std::uint64_t ns) {
+    std::size_t i = 0;
+    for (std::uint64_t limit = 1; ns > limit && i < RouteStats::buckets; limit <<= 1) {
+        ++i;
+    }
+    return i;
+}
+
+}  // namespace
+
+TRANSFORMATIONS_STATS_TLS StatsShard *Stats::_current = nullptr;
+
+struct Stats::Owner {
+    Shard *shard = nullptr;
+
+    ~Owner();
+};
+
+thread_local Stats::Owner Stats::_owner;
+
+Stats::Owner::~Owner() {
+    if (shard != nullptr) {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        add(r.retired, *shard);
+        r.shards.erase(std::find(r.shards.begin(), r.shards.end(), shard));
+        delete shard;
+    }
+    _current = nullptr;
+    owner_destroyed = true;
+}
+
+StatsShard &Stats::attach() {
+    Shard *shard = new Shard;
+    {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.shards.push_back(shard);
+    }
+    if (!owner_destroyed) {
+        _owner.shard = shard;
+    }
+    _current = shard;
+    return *shard;
+}
+
+void Stats::record(ROUTE route, std::size_t points, std::uint64_t ns) {
+    Shard::Route &stats = (_current ? *_current : attach()).routes[static_cast<std::size_t>(route)];
+    add(stats.points, points);
+    add(stats.timed_calls, 1);
+    add(stats.total_ns, ns);
+    add(stats.histogram[bucket(ns)], 1);
+}
+
+Stats::Snapshot Stats::snapshot() {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Snapshot snapshot = r.totals();
+    for (std::size_t i = 0; i < route_count; ++i) {
+        snapshot[i].points -= r.baseline[i].points;
+        snapshot[i].timed_calls -= r.baseline[i].timed_calls;
+        snapshot[i].total_ns -= r.baseline[i].total_ns;
+        for (std::size_t b = 0; b <= RouteStats::buckets; ++b) {
+            snapshot[i].histogram[b] -= r.baseline[i].histogram[b];
+        }
+    }
+    return snapshot;
+}
+
+void Stats::reset() {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.baseline = r.totals();
+}
+
+const char *Stats::name(ROUTE route) {
+    switch (route) {
+        case ROUTE::WGS84_FROM_SK42: return "wgs84_from_sk42";
+        case ROUTE::WGS84_FROM_PZ90: return "wgs84_from_pz90";
+        case ROUTE::WGS84_FROM_UTM: return "wgs84_from_utm";
+        case ROUTE::SK42_FROM_WGS84: return "sk42_from_wgs84";
+        case ROUTE::SK42_FROM_GAUSS_KRUGER: return "sk42_from_gauss_kruger";
+        case ROUTE::PZ90_FROM_WGS84: return "pz90_from_wgs84";
+        case ROUTE::GAUSS_KRUGER_FROM_SK42: return "gauss_kruger_from_sk42";
+        case ROUTE::GAUSS_KRUGER_JACOBIAN: return "gauss_kruger_jacobian";
+        case ROUTE::UTM_FROM_WGS84: return "utm_from_wgs84";
+        case ROUTE::ECEF_FROM_GEODETIC: return "ecef_from_geodetic";
+        case ROUTE::GEODETIC_FROM_ECEF: return "geodetic_from_ecef";
+        case ROUTE::HELMERT: return "helmert";
+        case ROUTE::NTV2: return "ntv2";
+        case ROUTE::LOCAL_FRAME: return "local_frame";
+        case ROUTE::GEOID: return "geoid";
+        case ROUTE::BATCH_TO_GAUSS_KRUGER: return "batch_to_gauss_kruger";
+        case ROUTE::BATCH_TO_UTM: return "batch_to_utm";
+        case ROUTE::BATCH_TO_WGS84: return "batch_to_wgs84";
+        case ROUTE::BATCH_TO_PZ90: return "batch_to_pz90";
+        case ROUTE::BATCH_GAUSS_KRUGER_JACOBIAN: return "batch_gauss_kruger_jacobian";
+        case ROUTE::BATCH_TO_ECEF: return "batch_to_ecef";
+        case ROUTE::BATCH_FROM_ECEF: return "batch_from_ecef";
+        case ROUTE::BATCH_HELMERT: return "batch_helmert";
+        case ROUTE::BATCH_NTV2: return "batch_ntv2";
+        case ROUTE::BATCH_LOCAL_FRAME: return "batch_local_frame";
+        case ROUTE::BATCH_ROUTE: return "batch_route";
+        case ROUTE::COUNT: break;
+    }
+    return "unknown";
+}
+
+void Stats::write_prometheus(std::ostream &out) {
+    Snapshot snap = snapshot();
+    out << "# TYPE transformations_points_total counter\n";
+    for (std::size_t r = 0; r < snap.size(); ++r) {
+        out << "transformations_points_total{route=\"" << name(static_cast<ROUTE>(r)) << "\"} " << snap[r].points
+            << '\n';
+    }
+    out << "# TYPE transformations_batch_duration_seconds histogram\n";
+    for (std::size_t r = 0; r < snap.size(); ++r) {
+        if (!timed(static_cast<ROUTE>(r))) {
+            continue;
+        }
+        const char *route = name(static_cast<ROUTE>(r));
+        std::uint64_t cumulative = 0;
+        for (std::size_t i = 0; i < RouteStats::buckets; ++i) {
+            cumulative += snap[r].histogram[i];
+            out << "transformations_batch_duration_seconds_bucket{route=\"" << route << "\",le=\""
+                << seconds(std::uint64_t{1} << i) << "\"} " << cumulative << '\n';
+        }
+        out << "transformations_batch_duration_seconds_bucket{route=\"" << route << "\",le=\"+Inf\"} "
+            << snap[r].timed_calls << '\n';
+        out << "transformations_batch_duration_seconds_sum{route=\"" << route << "\"} "
+            << static_cast<double>(snap[r].total_ns) * 1e-9 << '\n';
+        out << "transformations_batch_duration_seconds_count{route=\"" << route << "\"} " << snap[r].timed_calls
+            << '\n';
+    }
+}
+
+bool Stats::write_prometheus(const std::string &path) {
+    std::ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    write_prometheus(out);
+    return static_cast<bool>(out);
+}
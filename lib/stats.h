@@ -0,0 +1,139 @@
+#ifndef TRANSFORMATION_LIB_STATS_H_
+#define TRANSFORMATION_LIB_STATS_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Conversion paths that are counted when the library is built with
+// TRANSFORMATIONS_STATS. Without it the instrumentation compiles to nothing.
+// Single-point routes are only counted; BATCH_ routes are also timed, once per
+// call, so reading the clock never costs more than a batch.
+enum class ROUTE {
+    WGS84_FROM_SK42,
+    WGS84_FROM_PZ90,
+    WGS84_FROM_UTM,
+    SK42_FROM_WGS84,
+    SK42_FROM_GAUSS_KRUGER,
+    PZ90_FROM_WGS84,
+    GAUSS_KRUGER_FROM_SK42,
+    GAUSS_KRUGER_JACOBIAN,
+    UTM_FROM_WGS84,
+    ECEF_FROM_GEODETIC,
+    GEODETIC_FROM_ECEF,
+    HELMERT,
+    NTV2,
+    LOCAL_FRAME,
+    GEOID,
+    BATCH_TO_GAUSS_KRUGER,
+    BATCH_TO_UTM,
+    BATCH_TO_WGS84,
+    BATCH_TO_PZ90,
+    BATCH_GAUSS_KRUGER_JACOBIAN,
+    BATCH_TO_ECEF,
+    BATCH_FROM_ECEF,
+    BATCH_HELMERT,
+    BATCH_NTV2,
+    BATCH_LOCAL_FRAME,
+    BATCH_ROUTE,
+    COUNT
+};
+
+struct RouteStats {
+    // Bucket i holds timed calls that took at most 2^i nanoseconds and more
+    // than 2^(i-1); the extra last bucket holds the slower ones.
+    static constexpr std::size_t buckets = 40;
+
+    std::uint64_t points{};
+    std::uint64_t timed_calls{};
+    std::uint64_t total_ns{};
+    std::array<std::uint64_t, buckets + 1> histogram{};
+};
+
+// The library is position-independent (it is linked into the shared C
+// library), so a plain thread_local costs a __tls_get_addr call and an
+// initialisation check per access. __thread with the initial-exec model is a
+// single load; a pointer fits the static TLS that glibc keeps for libraries
+// loaded with dlopen().
+#if defined(__GNUC__)
+#define TRANSFORMATIONS_STATS_TLS __thread __attribute__((tls_model("initial-exec")))
+#else
+#define TRANSFORMATIONS_STATS_TLS thread_local
+#endif
+
+// One thread's counters. Only the owning thread writes them, with plain
+// relaxed loads and stores; the atomics let the exporter read them meanwhile.
+struct StatsShard {
+    struct Route {
+        std::atomic<std::uint64_t> points{};
+        std::atomic<std::uint64_t> timed_calls{};
+        std::atomic<std::uint64_t> total_ns{};
+        std::array<std::atomic<std::uint64_t>, RouteStats::buckets + 1> histogram{};
+    };
+    Route routes[static_cast<std::size_t>(ROUTE::COUNT)];
+};
+
+// Counters live in per-thread shards, so recording never contends; readers
+// add up the shards of running threads and those of threads that exited.
+class Stats {
+ public:
+    using Snapshot = std::array<RouteStats, static_cast<std::size_t>(ROUTE::COUNT)>;
+
+    static void count(ROUTE route);
+    static void record(ROUTE route, std::size_t points, std::uint64_t ns);
+    static Snapshot snapshot();
+    static void reset();
+
+    static const char *name(ROUTE route);
+    static bool timed(ROUTE route) { return route >= ROUTE::BATCH_TO_GAUSS_KRUGER; }
+    // Prometheus text exposition format: a point counter per route and a
+    // duration histogram per batch route.
+    static void write_prometheus(std::ostream &out);
+    static bool write_prometheus(const std::string &path);
+
+ private:
+    // Retires the calling thread's shard when the thread exits.
+    struct Owner;
+
+    // Registers a shard for the calling thread on its first count.
+    static StatsShard &attach();
+
+    static TRANSFORMATIONS_STATS_TLS StatsShard *_current;
+    static thread_local Owner _owner;
+};
+
+// Inline, so counting a point costs a TLS load, a test and an add.
+inline void Stats::count(ROUTE route) {
+    StatsShard *shard = _current ? _current : &attach();
+    std::atomic<std::uint64_t> &points = shard->routes[static_cast<std::size_t>(route)].points;
+    points.store(points.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+class BatchTimer {
+ public:
+    BatchTimer(ROUTE route, std::size_t points)
+        : _route(route), _points(points), _start(std::chrono::steady_clock::now()) {}
+    ~BatchTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - _start;
+        Stats::record(_route, _points, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+ private:
+    ROUTE _route;
+    std::size_t _points;
+    std::chrono::steady_clock::time_point _start;
+};
+
+#ifdef TRANSFORMATIONS_STATS
+#define TRANSFORMATIONS_COUNTED(route) Stats::count(route)
+#define TRANSFORMATIONS_TIMED(route, points) BatchTimer batch_timer_(route, points)
+#else
+#define TRANSFORMATIONS_COUNTED(route) static_cast<void>(0)
+#define TRANSFORMATIONS_TIMED(route, points) static_cast<void>(0)
+#endif
+
+#endif  // TRANSFORMATION_LIB_STATS_H_
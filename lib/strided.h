@@ -0,0 +1,61 @@
+#ifndef TRANSFORMATION_LIB_STRIDED_H_
+#define TRANSFORMATION_LIB_STRIDED_H_
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+constexpr std::ptrdiff_t dynamic_stride = 0;
+
+// View of `size` values of type T laid out `stride` bytes apart. With a
+// compile-time Stride the address arithmetic is a constant, so loops over
+// separate columns (Stride == sizeof(T)) or packed structs
+// (Stride == sizeof(Struct)) compile to plain or deinterleaving loads without
+// copying the input into per-point objects first.
+template <class T, std::ptrdiff_t Stride = dynamic_stride>
+class StridedView {
+ public:
+    using value_type = typename std::remove_const<T>::type;
+    using byte = typename std::conditional<std::is_const<T>::value, const char, char>::type;
+
+    StridedView(T *data, std::size_t size, std::ptrdiff_t stride = Stride)
+        : _data(reinterpret_cast<byte *>(data)), _size(size), _stride(Stride == dynamic_stride ? stride : Stride) {}
+
+    std::size_t size() const { return _size; }
+
+    value_type operator[](std::size_t i) const {
+        value_type value;
+        std::memcpy(&value, _data + offset(i), sizeof(value));
+        return value;
+    }
+    void set(std::size_t i, value_type value) const {
+        std::memcpy(_data + offset(i), &value, sizeof(value));
+    }
+
+ private:
+    std::ptrdiff_t offset(std::size_t i) const {
+        return static_cast<std::ptrdiff_t>(i) * (Stride == dynamic_stride ? _stride : Stride);
+    }
+
+    byte *_data;
+    std::size_t _size;
+    std::ptrdiff_t _stride;
+};
+
+// A separate array of values (SoA layout).
+template <class T>
+StridedView<T, sizeof(T)> column(T *data, std::size_t size) {
+    return StridedView<T, sizeof(T)>(data, size);
+}
+
+// One field of an array of structs (AoS layout), e.g. member(points, n, &Fix::latitude).
+template <class Struct, class T>
+StridedView<const T, sizeof(Struct)> member(const Struct *data, std::size_t size, T Struct::*field) {
+    return StridedView<const T, sizeof(Struct)>(&(data->*field), size);
+}
+template <class Struct, class T>
+StridedView<T, sizeof(Struct)> member(Struct *data, std::size_t size, T Struct::*field) {
+    return StridedView<T, sizeof(Struct)>(&(data->*field), size);
+}
+
+#endif  // TRANSFORMATION_LIB_STRIDED_H_
@@ -0,0 +1,82 @@
+#include "thread_pool.h"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+ThreadPool::ThreadPool(std::size_t workers) {
+    for (std::size_t i = 0; i < workers; ++i) {
+        _workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _ready.notify_all();
+    for (std::thread &worker : _workers) {
+        worker.join();
+    }
+}
+
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+    _ready.notify_one();
+}
+
+void ThreadPool::work() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _ready.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+            if (_tasks.empty()) {
+                return;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::run(std::size_t parts, const std::function<void(std::size_t)> &part) {
+    // Parts are claimed from a counter by the caller and by helper tasks. A
+    // helper that starts after every part is claimed only touches the shared
+    // state, which outlives this call.
+    struct State {
+        std::atomic<std::size_t> next{0};
+        std::size_t finished = 0;
+        std::mutex mutex;
+        std::condition_variable done;
+        const std::function<void(std::size_t)> *part = nullptr;
+    };
+    auto state = std::make_shared<State>();
+    state->part = &part;
+    auto claim = [state, parts] {
+        for (std::size_t i; (i = state->next++) < parts;) {
+            (*state->part)(i);
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (++state->finished == parts) {
+                state->done.notify_all();
+            }
+        }
+    };
+
+    for (std::size_t helper = 1; helper < std::min(parts, workers() + 1); ++helper) {
+        submit(claim);
+    }
+    claim();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->finished == parts; });
+}
@@ -0,0 +1,63 @@
+#ifndef TRANSFORMATION_LIB_THREAD_POOL_H_
+#define TRANSFORMATION_LIB_THREAD_POOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads fed from one queue. shared() is started on
+// first use with one worker per hardware thread and lives until exit.
+class ThreadPool {
+ public:
+    explicit ThreadPool(std::size_t workers);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    // Finishes the queued tasks, then joins the workers.
+    ~ThreadPool();
+
+    static ThreadPool &shared();
+
+    std::size_t workers() const { return _workers.size(); }
+
+    // Queues `task` to run on a worker.
+    void submit(std::function<void()> task);
+
+    // Calls body(begin, end) over consecutive ranges covering [0, count) of
+    // at least `grain` items and returns when all of them are done. The caller
+    // takes ranges too, so a task may itself call parallel_for() without
+    // deadlocking the pool.
+    template <class Body>
+    void parallel_for(std::size_t count, std::size_t grain, const Body &body);
+
+ private:
+    void run(std::size_t parts, const std::function<void(std::size_t)> &part);
+    void work();
+
+    std::mutex _mutex;
+    std::condition_variable _ready;
+    std::deque<std::function<void()>> _tasks;
+    bool _stopping = false;
+    std::vector<std::thread> _workers;
+};
+
+template <class Body>
+void ThreadPool::parallel_for(std::size_t count, std::size_t grain, const Body &body) {
+    // A few ranges per thread, so uneven ranges still balance.
+    std::size_t parts = std::min((count + grain - 1) / std::max<std::size_t>(grain, 1), 4 * (workers() + 1));
+    if (parts <= 1) {
+        if (count > 0) {
+            body(std::size_t{0}, count);
+        }
+        return;
+    }
+    std::size_t step = (count + parts - 1) / parts;
+    parts = (count + step - 1) / step;
+    run(parts, [&](std::size_t part) { body(part * step, std::min(count, part * step + step)); });
+}
+
+#endif  // TRANSFORMATION_LIB_THREAD_POOL_H_
@@ -1,135 +1,295 @@
 #include "transformations.h"
 
+#include "dual.h"
+#include "elementary.h"
+#include "stats.h"
+#include "utm_series.h"
+
 #include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
 #include <utility>
 
-using std::sin;
-using std::cos;
-using std::sinh;
-using std::cosh;
-using std::tanh;
-using std::atanh;
-using std::pow;
-using std::round;
-using std::sqrt;
+// Dual-number forms of the elementary functions, for the Jacobians.
+namespace math {
+
+template <std::size_t N>
+Dual<N> sin(const Dual<N> &x) {
+    return x.apply(sin(x.value), cos(x.value));
+}
+template <std::size_t N>
+Dual<N> cos(const Dual<N> &x) {
+    return x.apply(cos(x.value), -sin(x.value));
+}
+template <std::size_t N>
+Dual<N> pow(const Dual<N> &x, double y) {
+    return x.apply(pow(x.value, y), y * pow(x.value, y - 1));
+}
+
+}  // namespace math
+
+namespace {
+
+using namespace utm_series;
+
+// UTM latitude bands of 8 degrees from 80S; X is stretched to 84N.
+constexpr char bands[] = "CDEFGHJKLMNPQRSTUVWX";
+constexpr int band_count = sizeof(bands) - 1;
+
+// Band letters are read case-insensitively.
+char band_letter(char letter) {
+    return letter >= 'a' && letter <= 'z' ? static_cast<char>(letter - 'a' + 'A') : letter;
+}
+
+// Convergence and scale factor of a transverse Mercator projection, built from
+// the terms the forward series already has: l is the longitude from the
+// central meridian, A = l cos B, T = tan^2 B and C = e'^2 cos^2 B.
+GridFactors grid_factors(double l, double sinB, double A, double T, double C, double ep2, double k0) {
+    double A2 = A * A;
+    double gamma = l * sinB * (1 + A2 / 3 * (1 + 3 * C + 2 * C * C) + A2 * A2 / 15 * (2 - T));
+    double k = k0 * (1 + (1 + C) * A2 / 2 + (5 - 4 * T + 42 * C + 13 * C * C - 28 * ep2) * A2 * A2 / 24 +
+        (61 - 148 * T + 16 * T * T) * A2 * A2 * A2 / 720);
+    return GridFactors{Radian{gamma}, k};
+}
+
+// Terms of the Gauss-Kruger series that depend on the latitude only; the
+// zone enters through Lo alone, see gauss_kruger_zone(). T is double, or a
+// Dual to carry derivatives through the series.
+template <class T>
+struct GaussKrugerTerms {
+    T B;
+    T sin2B;
+    T cosB;
+    T xa, xb, xc, xd, x0;
+    T ya, yb, yc, y0;
+};
+
+template <class T>
+GaussKrugerTerms<T> gauss_kruger_terms(T B) {
+    T s2 = math::pow(math::sin(B), 2);
+    T s4 = math::pow(math::sin(B), 4);
+    T s6 = math::pow(math::sin(B), 6);
+    GaussKrugerTerms<T> t{};
+    t.B = B;
+    t.sin2B = math::sin(B * 2);
+    t.cosB = math::cos(B);
+    t.xa = 109500 - 574700 * s2 + 863700 * s4 - 398600 * s6;
+    t.xb = 278194 - 830174 * s2 + 572434 * s4 - 16010 * s6;
+    t.xc = 672483.4 - 811219.9 * s2 + 5420 * s4 - 10.6 * s6;
+    t.xd = 1594561.25 + 5336.535 * s2 + 26.79 * s4 + 0.149 * s6;
+    t.x0 = 16002.89 + 66.9607 * s2 + 0.3515 * s4;
+    t.ya = 79690 - 866190 * s2 + 1730360 * s4 - 945460 * s6;
+    t.yb = 270806 - 1523417 * s2 + 1327645 * s4 - 21701 * s6;
+    t.yc = 1070204.16 - 2136826.66 * s2 + 17.98 * s4 - 11.99 * s6;
+    t.y0 = 6378245 + 21346.1415 * s2 + 107.159 * s4 + 0.5977 * s6;
+    return t;
+}
+
+// Lo is the longitude from the central meridian of zone No, in radians.
+template <class T>
+void gauss_kruger_zone(const GaussKrugerTerms<T> &t, T Lo, int No, T &x, T &y) {
+    T Lo2 = math::pow(Lo, 2);
+    T Xa = Lo2 * t.xa;
+    T Xb = Lo2 * (t.xb + Xa);
+    T Xc = Lo2 * (t.xc + Xb);
+    T Xd = Lo2 * (t.xd + Xc);
+    x = 6367558.4968 * t.B - t.sin2B * (t.x0 - Xd);
+
+    T Ya = Lo2 * t.ya;
+    T Yb = Lo2 * (t.yb + Ya);
+    T Yc = Lo2 * (t.yc + Yb);
+    y = (5 + 10 * No) * 100000 + Lo * t.cosB * (t.y0 + Yc);
+}
+
+// Latitude-only terms of the UTM series, see utm_zone().
+struct UTMTerms {
+    double latRad;
+    double tanLat;
+    double cosLat;
+    double N_;
+    double T;
+    double C;
+    double M;
+};
+
+UTMTerms utm_terms(double latRad) {
+    UTMTerms t{};
+    t.latRad = latRad;
+    t.tanLat = math::tan(latRad);
+    t.cosLat = math::cos(latRad);
+    t.N_ = WGS84::_a / math::sqrt(1 - WGS84::_e2 * math::pow(math::sin(latRad), 2));
+    t.T = math::tan(latRad) * math::tan(latRad);
+    t.C = ep2 * math::pow(math::cos(latRad), 2);
+    t.M = WGS84::_a * latRad * (m0 - math::sin(2 * latRad) * m2 + math::sin(4 * latRad) * m4 - math::sin(6 * latRad) * m6);
+    return t;
+}
+
+// Easting and northing (without the southern offset) in zone `zoneNumber`;
+// returns A, the longitude term shared with grid_factors().
+double utm_zone(const UTMTerms &t, double longRad, int zoneNumber, double &E, double &N) {
+    // +3 puts origin in middle of zone
+    Degree lambda0{(zoneNumber - 1) * 6 - 177};
+    Radian lambda0Rad = lambda0;
+    double A = t.cosLat * (longRad - lambda0Rad);
+    double T = t.T;
+    double C = t.C;
+
+    E = UTM::k0 * t.N_ * (A + (1 - T + C) * math::pow(A, 3) / 6 +
+        (5 - 18 * T + math::pow(T, 2) + 72 * C - 58 * ep2) * math::pow(A, 5) / 120) + UTM::E0;
+
+    N = UTM::k0 * (t.M + t.N_ * t.tanLat *
+        (A * A / 2 + (5 - T + 9 * C + 4 * C * C) * math::pow(A, 4) / 24 +
+            (61 - 58 * T + T * T + 600 * C - 330 * ep2) * math::pow(A, 5) / 720));
+    return A;
+}
+
+// Truncates a zone number computed in floating point. The cast is undefined
+// for NaN and values beyond int, so those give 0, which validate() flags.
+int zone_number(double zone) {
+    return std::fabs(zone) < 1000 ? static_cast<int>(zone) : 0;
+}
+
+// Zones passed to in_zones() are chosen by the caller, so a bad one is a
+// programming error rather than bad data.
+void check_zone(int zone) {
+    if (zone < 1 || zone > 60) {
+        throw std::invalid_argument("in_zones: zone numbers must be 1-60");
+    }
+}
+void check_zones(const std::vector<int> &zones) {
+    for (int zone : zones) {
+        check_zone(zone);
+    }
+}
+
+}  // namespace
+
+// Definitions of the constexpr members that are bound to references (C++11).
+constexpr Params SK42::p;
+constexpr Params PZ90::p;
 
 double Geo::dB(Radian B, Radian L, double H, Params p) {
-    double M = p.a * (1 - p.e2) / pow((1 - p.e2 * pow(sin(B), 2)), 1.5);
-    double N = p.a * pow((1 - p.e2 * pow(sin(B), 2)), -0.5);
-    return ro / (M + H) * (N / p.a * p.e2 * sin(B) * cos(B) * p.da + ((N * N) / (p.a * p.a) + 1) * N * sin(B) * cos(B) * p.de2 / 2 - (p.dx * cos(L) + p.dy * sin(L)) * sin(B) + p.dz * cos(B));
+    double M = p.a * (1 - p.e2) / math::pow((1 - p.e2 * math::pow(math::sin(B), 2)), 1.5);
+    double N = p.a * math::pow((1 - p.e2 * math::pow(math::sin(B), 2)), -0.5);
+    return ro / (M + H) * (N / p.a * p.e2 * math::sin(B) * math::cos(B) * p.da + ((N * N) / (p.a * p.a) + 1) * N * math::sin(B) * math::cos(B) * p.de2 / 2 - (p.dx * math::cos(L) + p.dy * math::sin(L)) * math::sin(B) + p.dz * math::cos(B));
 }
 double Geo::dL(Radian B, Radian L, double H, Params p) {
-    double N = p.a * pow((1 - p.e2 * pow(sin(B), 2)), -0.5);
-    return ro / ((N + H) * cos(B)) * (-p.dx * sin(L) + p.dy * cos(L));
+    double N = p.a * math::pow((1 - p.e2 * math::pow(math::sin(B), 2)), -0.5);
+    return ro / ((N + H) * math::cos(B)) * (-p.dx * math::sin(L) + p.dy * math::cos(L));
 }
 double Geo::dH(Radian B, Radian L, double H, Params p) {
-    double N = p.a * pow((1 - p.e2 * pow(sin(B), 2)), -0.5);
-    double dH = -p.a / N * p.da + N * pow(sin(B), 2) * p.de2 / 2 + (p.dx * cos(L) + p.dy * sin(L)) * cos(B) + p.dz * sin(B);
+    double N = p.a * math::pow((1 - p.e2 * math::pow(math::sin(B), 2)), -0.5);
+    double dH = -p.a / N * p.da + N * math::pow(math::sin(B), 2) * p.de2 / 2 + (p.dx * math::cos(L) + p.dy * math::sin(L)) * math::cos(B) + p.dz * math::sin(B);
     return dH;
 }
 
 WGS84::WGS84(SK42 sk_42) {
+    TRANSFORMATIONS_COUNTED(ROUTE::WGS84_FROM_SK42);
     altitude = sk_42.altitude;
     latitude = Degree{sk_42.latitude + dB(sk_42.latitude, sk_42.longitude, sk_42.altitude, sk_42.p) / 3600};
     longitude = Degree{sk_42.longitude + dL(sk_42.latitude, sk_42.longitude, sk_42.altitude, sk_42.p) / 3600};
 }
 WGS84::WGS84(PZ90 pz_90) {
+    TRANSFORMATIONS_COUNTED(ROUTE::WGS84_FROM_PZ90);
     altitude = pz_90.altitude;
     latitude = Degree{pz_90.latitude + dB(pz_90.latitude, pz_90.longitude, pz_90.altitude, pz_90.p) / 3600};
     longitude = Degree{pz_90.longitude + dL(pz_90.latitude, pz_90.longitude, pz_90.altitude, pz_90.p) / 3600};
 }
 WGS84::WGS84(UTM utm) {
-    altitude = utm.altitude;
-    double e1 = (1 - sqrt(1 - WGS84::_e2)) / (1 + sqrt(1 - WGS84::_e2));
-
-    double x = utm.E - UTM::E0;  // remove 500,000 meter offset for longitude
-    double y = utm.N;
-
-    char zoneLetter = utm.zone[utm.zone.length() - 1];
-    int zoneNumber = std::stoi(utm.zone.substr(0, utm.zone.length() - 1));
-    if ((zoneLetter - 'N') < 0) {
-        // remove 10,000,000 meter offset used for southern hemisphere
-        y -= UTM::N0;
+    int zoneNumber = 0;
+    char zoneLetter = 0;
+    if (!UTM::parse_zone(utm.zone, zoneNumber, zoneLetter)) {
+        // unproject() rejects zone 0; flagged by validate(UTM) instead of throwing
+        zoneNumber = 0;
     }
-
-    // +3 puts origin in middle of zone
-    double lambda0 = (zoneNumber - 1) * 6 - 180 + 3;
-    static const double EPrimeSquared = (WGS84::_e2) / (1 - WGS84::_e2);
-
-    double M = y / UTM::k0;
-    double mu = M /
-        (WGS84::_a * (1 - WGS84::_e2 / 4 - 3 * WGS84::_e2 * WGS84::_e2 / 64
-            - 5 * WGS84::_e2 * WGS84::_e2 * WGS84::_e2 / 256));
-
-    Radian phi1Rad = Radian{mu + sin(2 * mu) * (3 * e1 / 2 - (27. / 32) * pow(e1, 3) / 32) +
-        sin(4 * mu) * ((21. / 16) * pow(e1, 2) - (55. / 32) * pow(e1, 4)) +
-        sin(6 * mu) * ((151. / 96) * pow(e1, 3))};
-
-    double N1 = WGS84::_a / sqrt(1 - WGS84::_e2 * pow(sin(phi1Rad), 2));
-    double T1 = tan(phi1Rad) * tan(phi1Rad);
-    double C1 = EPrimeSquared * pow(cos(phi1Rad), 2);
-    double R1 = WGS84::_a * (1 - WGS84::_e2) / pow(1 - WGS84::_e2 * pow(sin(phi1Rad), 2), 1.5);
-    double D = x / (N1 * UTM::k0);
-
-    Radian latRad = Radian{phi1Rad - ((N1 * tan(phi1Rad) / R1) *
-        (D * D / 2 - (5 + 3 * T1 + 10 * C1 - 4 * pow(C1, 2) - 9 * EPrimeSquared) * pow(D, 4) / 24 +
-            (61 + 90 * T1 + 298 * C1 + 45 * pow(T1, 2) - 252 * EPrimeSquared - 3 * pow(C1, 2))
-                * pow(D, 6) / 720))};
-
-    latitude = latRad;
-
-    Radian longRad = Radian{(D - (1 + 2 * T1 + C1) * pow(D, 3) / 6 +
-        (5 - 2 * C1 + 28 * T1 - 3 * pow(C1, 2) + 8 * EPrimeSquared + 24 * pow(T1, 2)) * pow(D, 5)
-            / 120) /
-        cos(phi1Rad)};
-    longitude = Degree{lambda0 + Degree{longRad}};
+    *this = UTM::unproject(utm.E, utm.N, utm.altitude, zoneNumber, zoneLetter);
 }
+SK42::SK42(Degree latitude, Degree longitude, double altitude)
+    : latitude(latitude), longitude(longitude), altitude(altitude) {}
 SK42::SK42(WGS84 wgs_84) {
+    TRANSFORMATIONS_COUNTED(ROUTE::SK42_FROM_WGS84);
     altitude = wgs_84.altitude;
     latitude = Degree{wgs_84.latitude - dB(wgs_84.latitude, wgs_84.longitude, wgs_84.altitude, p) / 3600};
     longitude = Degree{wgs_84.longitude - dL(wgs_84.latitude, wgs_84.longitude, wgs_84.altitude, p) / 3600};
 }
 
 SK42::SK42(GaussKruger gk) {
+    TRANSFORMATIONS_COUNTED(ROUTE::SK42_FROM_GAUSS_KRUGER);
     altitude = gk.height;
 
-    int No = gk.y * pow(10, -6);
+    int No = zone_number(gk.y * math::pow(10, -6));
     double Bi = gk.x / 6367558.4968;
-    double Bo = Bi + sin(Bi * 2) * (0.00252588685 - 0.0000149186 * pow(sin(Bi), 2) + 0.00000011904 * pow(sin(Bi), 4));
-    double Zo = (gk.y - (10 * No + 5) * 100000) / (6378245 * cos(Bo));
-    double Ba = Zo * Zo * (0.01672 - 0.0063 * pow(sin(Bo), 2) + 0.01188 * pow(sin(Bo), 4) - 0.00328 * pow(sin(Bo), 6));
-    double Bb = Zo * Zo * (0.042858 - 0.025318 * pow(sin(Bo), 2) + 0.014346 * pow(sin(Bo), 4) - 0.001264 * pow(sin(Bo), 6) - Ba);
-    double Bc = Zo * Zo * (0.10500614 - 0.04559916 * pow(sin(Bo), 2) + 0.00228901 * pow(sin(Bo), 4) - 0.00002987 * pow(sin(Bo), 6) - Bb);
-    double dB = Zo * Zo * sin(Bo * 2) * (0.251684631 - 0.003369263 * pow(sin(Bo), 2) + 0.000011276 * pow(sin(Bo), 4) - Bc);
+    double Bo = Bi + math::sin(Bi * 2) * (0.00252588685 - 0.0000149186 * math::pow(math::sin(Bi), 2) + 0.00000011904 * math::pow(math::sin(Bi), 4));
+    double Zo = (gk.y - (10 * No + 5) * 100000) / (6378245 * math::cos(Bo));
+    double Ba = Zo * Zo * (0.01672 - 0.0063 * math::pow(math::sin(Bo), 2) + 0.01188 * math::pow(math::sin(Bo), 4) - 0.00328 * math::pow(math::sin(Bo), 6));
+    double Bb = Zo * Zo * (0.042858 - 0.025318 * math::pow(math::sin(Bo), 2) + 0.014346 * math::pow(math::sin(Bo), 4) - 0.001264 * math::pow(math::sin(Bo), 6) - Ba);
+    double Bc = Zo * Zo * (0.10500614 - 0.04559916 * math::pow(math::sin(Bo), 2) + 0.00228901 * math::pow(math::sin(Bo), 4) - 0.00002987 * math::pow(math::sin(Bo), 6) - Bb);
+    double dB = Zo * Zo * math::sin(Bo * 2) * (0.251684631 - 0.003369263 * math::pow(math::sin(Bo), 2) + 0.000011276 * math::pow(math::sin(Bo), 4) - Bc);
     latitude = Radian{Bo - dB};
 
-    double La = Zo * Zo * (0.0038 + 0.0524 * pow(sin(Bo) , 2) + 0.0482 * pow(sin(Bo) , 4) + 0.0032 * pow(sin(Bo) , 6));
-    double Lb = Zo * Zo * (0.01225 + 0.09477 * pow(sin(Bo) , 2) + 0.03282 * pow(sin(Bo) , 4) - 0.00034 * pow(sin(Bo) , 6) - La);
-    double Lc = Zo * Zo * (0.0420025 + 0.1487407 * pow(sin(Bo) , 2) + 0.005942 * pow(sin(Bo) , 4) - 0.000015 * pow(sin(Bo) , 6) - Lb);
-    double Ld = Zo * Zo * (0.16778975 + 0.16273586 * pow(sin(Bo) , 2) - 0.0005249 * pow(sin(Bo) , 4) - 0.00000846 * pow(sin(Bo) , 6) - Lc);
-    double dL = Zo * (1 - 0.0033467108 * pow(sin(Bo) , 2) - 0.0000056002 * pow(sin(Bo) , 4) - 0.0000000187 * pow(sin(Bo) , 6) - Ld);
+    double La = Zo * Zo * (0.0038 + 0.0524 * math::pow(math::sin(Bo) , 2) + 0.0482 * math::pow(math::sin(Bo) , 4) + 0.0032 * math::pow(math::sin(Bo) , 6));
+    double Lb = Zo * Zo * (0.01225 + 0.09477 * math::pow(math::sin(Bo) , 2) + 0.03282 * math::pow(math::sin(Bo) , 4) - 0.00034 * math::pow(math::sin(Bo) , 6) - La);
+    double Lc = Zo * Zo * (0.0420025 + 0.1487407 * math::pow(math::sin(Bo) , 2) + 0.005942 * math::pow(math::sin(Bo) , 4) - 0.000015 * math::pow(math::sin(Bo) , 6) - Lb);
+    double Ld = Zo * Zo * (0.16778975 + 0.16273586 * math::pow(math::sin(Bo) , 2) - 0.0005249 * math::pow(math::sin(Bo) , 4) - 0.00000846 * math::pow(math::sin(Bo) , 6) - Lc);
+    double dL = Zo * (1 - 0.0033467108 * math::pow(math::sin(Bo) , 2) - 0.0000056002 * math::pow(math::sin(Bo) , 4) - 0.0000000187 * math::pow(math::sin(Bo) , 6) - Ld);
     longitude = Radian{Radian{Degree{6 * (No - 0.5)}} + dL};
 }
-GaussKruger::GaussKruger(SK42 sk_42) : height(sk_42.altitude) {
+GaussKruger::GaussKruger(SK42 sk_42) : GaussKruger(sk_42, nullptr) {}
+GaussKruger::GaussKruger(SK42 sk_42, GridFactors &factors) : GaussKruger(sk_42, &factors) {}
+GaussKruger::GaussKruger(SK42 sk_42, GridFactors *factors) : height(sk_42.altitude) {
+    TRANSFORMATIONS_COUNTED(ROUTE::GAUSS_KRUGER_FROM_SK42);
     double L = sk_42.longitude;
     Radian B = sk_42.latitude;
-    int No = (6 + L) / 6;
+    int No = zone_number((6 + L) / 6);
     double Lo = Radian{Degree{L - (3 + 6 * (No - 1))}};
-    double Xa = pow(Lo, 2) * (109500 - 574700 * pow(sin(B), 2) + 863700 * pow(sin(B), 4) - 398600 * pow(sin(B), 6));
-    double Xb = pow(Lo, 2) * (278194 - 830174 * pow(sin(B), 2) + 572434 * pow(sin(B), 4) - 16010 * pow(sin(B), 6) + Xa);
-    double Xc = pow(Lo, 2) * (672483.4 - 811219.9 * pow(sin(B), 2) + 5420 * pow(sin(B), 4) - 10.6 * pow(sin(B), 6) + Xb);
-    double Xd = pow(Lo, 2) * (1594561.25 + 5336.535 * pow(sin(B), 2) + 26.79 * pow(sin(B), 4) + 0.149 * pow(sin(B), 6) + Xc);
-    x = 6367558.4968 * B - sin(B * 2) * (16002.89 + 66.9607 * pow(sin(B), 2) + 0.3515 * pow(sin(B), 4) - Xd);
+    GaussKrugerTerms<double> terms = gauss_kruger_terms<double>(B);
+    gauss_kruger_zone(terms, Lo, No, x, y);
 
-    double Ya = pow(Lo, 2) * (79690 - 866190 * pow(sin(B), 2) + 1730360 * pow(sin(B), 4) - 945460 * pow(sin(B), 6));
-    double Yb = pow(Lo, 2) * (270806 - 1523417 * pow(sin(B), 2) + 1327645 * pow(sin(B), 4) - 21701 * pow(sin(B), 6) + Ya);
-    double Yc = pow(Lo, 2) * (1070204.16 - 2136826.66 * pow(sin(B), 2) + 17.98 * pow(sin(B), 4) - 11.99 * pow(sin(B), 6) + Yb);
-    y = (5 + 10 * No) * 100000 + Lo * cos(B) * (6378245 + 21346.1415 * pow(sin(B), 2) + 107.159 * pow(sin(B), 4) + 0.5977 * pow(sin(B), 6) + Yc);
+    if (factors) {
+        double T = math::tan(B) * math::tan(B);
+        double C = ep2 * math::pow(math::cos(B), 2);
+        *factors = grid_factors(Lo, math::sin(B), Lo * math::cos(B), T, C, ep2, 1);
+    }
+}
+GaussKruger::GaussKruger(SK42 sk_42, Jacobian &jacobian) : height(sk_42.altitude) {
+    TRANSFORMATIONS_COUNTED(ROUTE::GAUSS_KRUGER_JACOBIAN);
+    double L = sk_42.longitude;
+    int No = zone_number((6 + L) / 6);
+    // Lo follows L one to one, so d/dLo is d/dL.
+    Dual<2> B = Dual<2>::variable(Radian{sk_42.latitude}, 0);
+    Dual<2> Lo = Dual<2>::variable(Radian{Degree{L - (3 + 6 * (No - 1))}}, 1);
+    Dual<2> X, Y;
+    gauss_kruger_zone(gauss_kruger_terms(B), Lo, No, X, Y);
+    x = X.value;
+    y = Y.value;
+    jacobian = Jacobian{X.d[0], X.d[1], Y.d[0], Y.d[1]};
+}
+std::vector<GaussKruger> GaussKruger::in_zones(SK42 sk_42, const std::vector<int> &zones) {
+    check_zones(zones);
+    double L = sk_42.longitude;
+    GaussKrugerTerms<double> terms = gauss_kruger_terms<double>(Radian{sk_42.latitude});
+    std::vector<GaussKruger> result(zones.size());
+    for (std::size_t i = 0; i < zones.size(); ++i) {
+        double Lo = Radian{Degree{L - (3 + 6 * (zones[i] - 1))}};
+        gauss_kruger_zone(terms, Lo, zones[i], result[i].x, result[i].y);
+        result[i].height = sk_42.altitude;
+    }
+    return result;
+}
+GaussKruger GaussKruger::in_zone(SK42 sk_42, int zone) {
+    check_zone(zone);
+    GaussKruger result;
+    double Lo = Radian{Degree{sk_42.longitude - (3 + 6 * (zone - 1))}};
+    gauss_kruger_zone(gauss_kruger_terms<double>(Radian{sk_42.latitude}), Lo, zone, result.x, result.y);
+    result.height = sk_42.altitude;
+    return result;
 }
 
 PZ90::PZ90(Degree latitude, Degree longitude, double altitude)
     : latitude(latitude), longitude(longitude), altitude(altitude) {}
 PZ90::PZ90(WGS84 wgs_84) {
+    TRANSFORMATIONS_COUNTED(ROUTE::PZ90_FROM_WGS84);
     altitude = wgs_84.altitude;
 
     latitude = Degree{wgs_84.latitude - dB(wgs_84.latitude, wgs_84.longitude, wgs_84.altitude, p) / 3600};
@@ -137,59 +297,52 @@ PZ90::PZ90(WGS84 wgs_84) {
 }
 
 char UTM::letter_designator(Degree latitude) {
-    if ((84 >= latitude) && (latitude >= 72)) {
-        return 'X';
-    } else if ((72 > latitude) && (latitude >= 64)) {
-        return 'W';
-    } else if ((64 > latitude) && (latitude >= 56)) {
-        return 'V';
-    } else if ((56 > latitude) && (latitude >= 48)) {
-        return 'U';
-    } else if ((48 > latitude) && (latitude >= 40)) {
-        return 'T';
-    } else if ((40 > latitude) && (latitude >= 32)) {
-        return 'S';
-    } else if ((32 > latitude) && (latitude >= 24)) {
-        return 'R';
-    } else if ((24 > latitude) && (latitude >= 16)) {
-        return 'Q';
-    } else if ((16 > latitude) && (latitude >= 8)) {
-        return 'P';
-    } else if ((8 > latitude) && (latitude >= 0)) {
-        return 'N';
-    } else if ((0 > latitude) && (latitude >= -8)) {
-        return 'M';
-    } else if ((-8 > latitude) && (latitude >= -16)) {
-        return 'L';
-    } else if ((-16 > latitude) && (latitude >= -24)) {
-        return 'K';
-    } else if ((-24 > latitude) && (latitude >= -32)) {
-        return 'J';
-    } else if ((-32 > latitude) && (latitude >= -40)) {
-        return 'H';
-    } else if ((-40 > latitude) && (latitude >= -48)) {
-        return 'G';
-    } else if ((-48 > latitude) && (latitude >= -56)) {
-        return 'F';
-    } else if ((-56 > latitude) && (latitude >= -64)) {
-        return 'E';
-    } else if ((-64 > latitude) && (latitude >= -72)) {
-        return 'D';
-    } else if ((-72 > latitude) && (latitude >= -80)) {
-        return 'C';
-    }
-    // 'Z' is an error flag, the latitudeitude is outside the UTM limits
+    if (latitude <= 84) {
+        for (int band = band_count - 1; band >= 0; --band) {
+            if (latitude >= -80 + 8 * band) {
+                return bands[band];
+            }
+        }
+    }
+    // 'Z' is an error flag, the latitude is outside the UTM limits
     return 'Z';
 }
+bool UTM::parse_zone(const std::string &zone, int &number, char &letter) {
+    if (zone.size() < 2 || zone.size() > 3) {
+        return false;
+    }
+    number = 0;
+    for (std::size_t i = 0; i + 1 < zone.size(); ++i) {
+        if (zone[i] < '0' || zone[i] > '9') {
+            return false;
+        }
+        number = number * 10 + (zone[i] - '0');
+    }
+    letter = band_letter(zone.back());
+    return valid_zone(number, letter);
+}
+bool UTM::valid_zone(int number, char letter) {
+    return number >= 1 && number <= 60 && letter != '\0' && std::strchr(bands, band_letter(letter)) != nullptr;
+}
 UTM::UTM(Degree E, Degree N, double altitude, std::string  zone)
     : E(E), N(N), altitude(altitude), zone(std::move(zone)) {}
-UTM::UTM(WGS84 wgs_84) {
-    altitude = wgs_84.altitude;
-
+UTM::UTM(WGS84 wgs_84) : UTM(wgs_84, nullptr) {}
+UTM::UTM(WGS84 wgs_84, GridFactors &factors) : UTM(wgs_84, &factors) {}
+UTM::UTM(WGS84 wgs_84, GridFactors *factors) : altitude(wgs_84.altitude) {
+    int zoneNumber = 0;
+    char zoneLetter = 0;
+    project(wgs_84, E, N, zoneNumber, zoneLetter, factors);
+    zone = std::to_string(zoneNumber) + zoneLetter;
+}
+void UTM::project(WGS84 wgs_84, double &E, double &N, int &number, char &letter) {
+    project(wgs_84, E, N, number, letter, nullptr);
+}
+void UTM::project(WGS84 wgs_84, double &E, double &N, int &number, char &letter, GridFactors *factors) {
+    TRANSFORMATIONS_COUNTED(ROUTE::UTM_FROM_WGS84);
     Radian latRad = wgs_84.latitude;
     Radian longRad = wgs_84.longitude;
 
-    int zoneNumber = static_cast<int>((wgs_84.longitude + 180) / 6) + 1;
+    int zoneNumber = zone_number((wgs_84.longitude + 180) / 6 + 1);
 
     if (wgs_84.latitude >= 56.0 && wgs_84.latitude < 64.0 && wgs_84.longitude >= 3.0 && wgs_84.longitude < 12.0) {
         zoneNumber = 32;
@@ -207,34 +360,131 @@ UTM::UTM(WGS84 wgs_84) {
             zoneNumber = 37;
         }
     }
+    number = zoneNumber;
+    letter = letter_designator(wgs_84.latitude);
+
+    UTMTerms terms = utm_terms(latRad);
+    double A = utm_zone(terms, longRad, zoneNumber, E, N);
+    if (wgs_84.latitude < 0) {
+        // 10000000 meter offset for southern hemisphere
+        N += N0;
+    }
+
+    if (factors) {
+        Radian lambda0Rad = Degree{(zoneNumber - 1) * 6 - 177};
+        *factors = grid_factors(longRad - lambda0Rad, math::sin(latRad), A, terms.T, terms.C, ep2, k0);
+    }
+}
+WGS84 UTM::unproject(double E, double N, double altitude, int number, char letter) {
+    TRANSFORMATIONS_COUNTED(ROUTE::WGS84_FROM_UTM);
+    WGS84 wgs_84;
+    wgs_84.altitude = altitude;
+
+    double x = E - E0;  // remove 500,000 meter offset for longitude
+    double y = N;
+
+    if (!valid_zone(number, letter)) {
+        // flagged by validate(UTM) instead of throwing
+        wgs_84.latitude = Degree{std::numeric_limits<double>::quiet_NaN()};
+        wgs_84.longitude = wgs_84.latitude;
+        return wgs_84;
+    }
+    if ((band_letter(letter) - 'N') < 0) {
+        // remove 10,000,000 meter offset used for southern hemisphere
+        y -= N0;
+    }
+
     // +3 puts origin in middle of zone
-    Degree lambda0{(zoneNumber - 1) * 6 - 177};
-    Radian lambda0Rad = lambda0;
+    double lambda0 = (number - 1) * 6 - 180 + 3;
 
-    // Compute the UTM Zone from the latitude and longitude
-    zone = std::to_string(zoneNumber) + letter_designator(wgs_84.latitude);
+    double M = y / k0;
+    double mu = M / mu_scale;
 
-    constexpr double EPrimeSquared = WGS84::_e2 / (1 - WGS84::_e2);
+    Radian phi1Rad = Radian{mu + math::sin(2 * mu) * phi2 + math::sin(4 * mu) * phi4 + math::sin(6 * mu) * phi6};
 
-    double N_ = WGS84::_a / sqrt(1 - WGS84::_e2 * pow(sin(latRad), 2));
-    double T = tan(latRad) * tan(latRad);
-    double C = EPrimeSquared * pow(cos(latRad), 2);
-    double A = cos(latRad) * (longRad - lambda0Rad);
+    double N1 = WGS84::_a / math::sqrt(1 - WGS84::_e2 * math::pow(math::sin(phi1Rad), 2));
+    double T1 = math::tan(phi1Rad) * math::tan(phi1Rad);
+    double C1 = ep2 * math::pow(math::cos(phi1Rad), 2);
+    double R1 = WGS84::_a * (1 - WGS84::_e2) / math::pow(1 - WGS84::_e2 * math::pow(math::sin(phi1Rad), 2), 1.5);
+    double D = x / (N1 * k0);
 
-    double M = WGS84::_a * latRad * ((1 - WGS84::_e2 / 4 - (3. / 64) * pow(WGS84::_e2, 2) - (5. / 256) * pow(WGS84::_e2, 3)) -
-            sin(2 * latRad) * ((3. / 8) * WGS84::_e2 + (3. / 32) * pow(WGS84::_e2, 2) + (45. / 1024) * pow(WGS84::_e2, 3)) +
-            sin(4 * latRad) * ((15. / 256) * pow(WGS84::_e2, 2) + (45. / 1024) * pow(WGS84::_e2, 3)) -
-            sin(6 * latRad) * ((35. / 3072) * pow(WGS84::_e2, 3)));
+    Radian latRad = Radian{phi1Rad - ((N1 * math::tan(phi1Rad) / R1) *
+        (D * D / 2 - (5 + 3 * T1 + 10 * C1 - 4 * math::pow(C1, 2) - 9 * ep2) * math::pow(D, 4) / 24 +
+            (61 + 90 * T1 + 298 * C1 + 45 * math::pow(T1, 2) - 252 * ep2 - 3 * math::pow(C1, 2))
+                * math::pow(D, 6) / 720))};
 
-    E = k0 * N_ * (A + (1 - T + C) * pow(A, 3) / 6 +
-        (5 - 18 * T + pow(T, 2) + 72 * C - 58 * EPrimeSquared) * pow(A, 5) / 120) + E0;
+    wgs_84.latitude = latRad;
 
-    N = k0 * (M + N_ * tan(latRad) *
-        (A * A / 2 + (5 - T + 9 * C + 4 * C * C) * pow(A, 4) / 24 +
-            (61 - 58 * T + T * T + 600 * C - 330 * EPrimeSquared) * pow(A, 5) / 720));
+    Radian longRad = Radian{(D - (1 + 2 * T1 + C1) * math::pow(D, 3) / 6 +
+        (5 - 2 * C1 + 28 * T1 - 3 * math::pow(C1, 2) + 8 * ep2 + 24 * math::pow(T1, 2)) * math::pow(D, 5)
+            / 120) /
+        math::cos(phi1Rad)};
+    wgs_84.longitude = Degree{lambda0 + Degree{longRad}};
+    return wgs_84;
+}
+std::vector<UTM> UTM::in_zones(WGS84 wgs_84, const std::vector<int> &zones) {
+    check_zones(zones);
+    Radian latRad = wgs_84.latitude;
+    Radian longRad = wgs_84.longitude;
+    char letter = letter_designator(wgs_84.latitude);
+    UTMTerms terms = utm_terms(latRad);
 
+    std::vector<UTM> result;
+    result.reserve(zones.size());
+    for (int zoneNumber : zones) {
+        double E_ = 0;
+        double N_ = 0;
+        utm_zone(terms, longRad, zoneNumber, E_, N_);
+        if (wgs_84.latitude < 0) {
+            N_ += N0;
+        }
+        result.push_back(UTM{Degree{E_}, Degree{N_}, wgs_84.altitude, std::to_string(zoneNumber) + letter});
+    }
+    return result;
+}
+UTM UTM::in_zone(WGS84 wgs_84, int zone) {
+    check_zone(zone);
+    double E_ = 0;
+    double N_ = 0;
+    utm_zone(utm_terms(Radian{wgs_84.latitude}), Radian{wgs_84.longitude}, zone, E_, N_);
     if (wgs_84.latitude < 0) {
-        // 10000000 meter offset for southern hemisphere
-        N += N0;
+        N_ += N0;
     }
+    return UTM{Degree{E_}, Degree{N_}, wgs_84.altitude, std::to_string(zone) + letter_designator(wgs_84.latitude)};
+}
+
+std::uint8_t validate(const WGS84 &wgs_84, bool for_utm) {
+    double latitude = wgs_84.latitude;
+    double longitude = wgs_84.longitude;
+    bool finite = std::isfinite(latitude) & std::isfinite(longitude) & std::isfinite(wgs_84.altitude);
+    bool out_of_range = (std::fabs(latitude) > 90) | (std::fabs(longitude) > 180) |
+        (for_utm & ((latitude < -80) | (latitude > 84)));
+    return static_cast<std::uint8_t>((!finite) * STATUS_NON_FINITE | out_of_range * STATUS_OUT_OF_RANGE);
+}
+std::uint8_t validate(const UTM &utm) {
+    int number = 0;
+    char letter = 0;
+    bool finite = std::isfinite(utm.E) & std::isfinite(utm.N) & std::isfinite(utm.altitude);
+    bool zone = UTM::parse_zone(utm.zone, number, letter);
+    return static_cast<std::uint8_t>((!finite) * STATUS_NON_FINITE | (!zone) * STATUS_INVALID_ZONE);
+}
+std::uint8_t validate(const GaussKruger &gk) {
+    bool finite = std::isfinite(gk.x) & std::isfinite(gk.y) & std::isfinite(gk.height);
+    // The zone number is the millions of the easting.
+    double zone = std::floor(gk.y * 1e-6);
+    bool valid_zone = (zone >= 1) & (zone <= 60);
+    bool out_of_range = std::fabs(gk.x) > 10002000;
+    return static_cast<std::uint8_t>((!finite) * STATUS_NON_FINITE | (!valid_zone) * STATUS_INVALID_ZONE |
+                                     out_of_range * STATUS_OUT_OF_RANGE);
+}
+
+Covariance propagate(const Jacobian &jacobian, const Covariance &covariance) {
+    // Rows of J C.
+    double a0 = jacobian.dx_dB * covariance.c00 + jacobian.dx_dL * covariance.c01;
+    double a1 = jacobian.dx_dB * covariance.c01 + jacobian.dx_dL * covariance.c11;
+    double b0 = jacobian.dy_dB * covariance.c00 + jacobian.dy_dL * covariance.c01;
+    double b1 = jacobian.dy_dB * covariance.c01 + jacobian.dy_dL * covariance.c11;
+    return Covariance{a0 * jacobian.dx_dB + a1 * jacobian.dx_dL,
+                      a0 * jacobian.dy_dB + a1 * jacobian.dy_dL,
+                      b0 * jacobian.dy_dB + b1 * jacobian.dy_dL};
 }
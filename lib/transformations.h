@@ -4,10 +4,21 @@
 #include "radian_degree.h"
 
 #include <array>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 enum class ELLIPSOID { PZ90, WGS84, SK42 };
 
+// Per-point validation flags, combined with |. Conversions never throw on bad
+// input; they produce unspecified (often NaN) values that validate() flags.
+enum STATUS : std::uint8_t {
+    STATUS_OK = 0,
+    STATUS_NON_FINITE = 1,
+    STATUS_OUT_OF_RANGE = 2,
+    STATUS_INVALID_ZONE = 4
+};
+
 struct Params {
     double a;
     double e2;
@@ -32,6 +43,7 @@ class SK42;
 class PZ90;
 class GaussKruger;
 class UTM;
+class ECEF;
 
 class WGS84 : public Geo {
  public:
@@ -41,6 +53,7 @@ class WGS84 : public Geo {
     explicit WGS84(SK42 sk_42);
     explicit WGS84(PZ90 pz_90);
     explicit WGS84(UTM utm);
+    explicit WGS84(ECEF ecef);
     Degree latitude{};
     Degree longitude{};
     double altitude{};
@@ -51,14 +64,22 @@ class WGS84 : public Geo {
 };
 
 class SK42 : public Geo {
+    // Declared first: p below is computed from them at compile time.
+    static constexpr double _a = 6378137;
+    static constexpr double _al = 1 / 298.257223563;
+    static constexpr double _e2 = 2 * _al - _al * _al;
+
  public:
+    SK42(Degree latitude, Degree longitude, double altitude);
     explicit SK42(WGS84 wgs_84);
     explicit SK42(GaussKruger gk);
+    explicit SK42(ECEF ecef);
 
     Degree latitude{};
     Degree longitude{};
     double altitude{};
-    Params p {
+    // Molodensky parameters to WGS84, shared by every point.
+    static constexpr Params p {
         (_a + WGS84::_a) / 2,
         (_e2 + WGS84::_e2) / 2,
         WGS84::_a - _a,
@@ -67,22 +88,22 @@ class SK42 : public Geo {
         -141.27,
         -80.9
     };
-
- private:
-    static constexpr double _a = 6378137;
-    static constexpr double _al = 1 / 298.257223563;
-    static constexpr double _e2 = 2 * _al - _al * _al;
 };
 
 class PZ90 : public Geo {
+    static constexpr double _a = 6378136.5;
+    static constexpr double _al = 1 / 298.25784;
+    static constexpr double _e2 = 2 * _al - _al * _al;
+
  public:
     PZ90(Degree latitude, Degree longitude, double altitude);
     explicit PZ90(WGS84 wgs_84);
+    explicit PZ90(ECEF ecef);
 
     Degree latitude{};
     Degree longitude{};
     double altitude{};
-    Params p {
+    static constexpr Params p {
         (_a + WGS84::_a) / 2,
         (_e2 + WGS84::_e2) / 2,
         WGS84::_a - _a,
@@ -91,18 +112,63 @@ class PZ90 : public Geo {
         -0.3,
         -0.9
     };
+};
 
- private:
-    static constexpr double _a = 6378136.5;
-    static constexpr double _al = 1 / 298.25784;
-    static constexpr double _e2 = 2 * _al - _al * _al;
+// Meridian convergence (angle from grid north to true north) and point scale
+// factor at a projected point.
+struct GridFactors {
+    Degree convergence;
+    double scale;
+};
+
+// Partial derivatives of projected coordinates with respect to latitude and
+// longitude, in metres per radian.
+struct Jacobian {
+    double dx_dB;
+    double dx_dL;
+    double dy_dB;
+    double dy_dL;
 };
 
+// Symmetric 2x2 covariance: of (B, L) in rad^2 on the geodetic side, of
+// (x, y) in m^2 on the projected side.
+struct Covariance {
+    double c00;
+    double c01;
+    double c11;
+};
+
+// J C J^T, the covariance of the projected coordinates.
+Covariance propagate(const Jacobian &jacobian, const Covariance &covariance);
+
 class UTM {
  public:
     explicit UTM(WGS84 wgs_84);
+    // Also reports the grid factors, reusing the terms of the projection.
+    UTM(WGS84 wgs_84, GridFactors &factors);
     UTM(Degree E, Degree N, double altitude, std::string  zone);
 
+    // Projects into each of the given zones (1-60) instead of the zone that
+    // contains the point; the latitude terms are computed once for all zones.
+    // Throws std::invalid_argument for a zone outside 1-60.
+    static std::vector<UTM> in_zones(WGS84 wgs_84, const std::vector<int> &zones);
+    // The same for one zone, without building any vector.
+    static UTM in_zone(WGS84 wgs_84, int zone);
+
+    // Splits "37U" into 37 and 'U'; false unless the number is 1-60 and the
+    // letter a valid latitude band. Band letters are case-insensitive: "37u"
+    // gives 'U' too.
+    static bool parse_zone(const std::string &zone, int &number, char &letter);
+
+    // The two conversions with the zone kept as a number and a band letter,
+    // for batch callers that hold the zone in numeric columns. unproject()
+    // returns NaN latitude and longitude unless the zone passes parse_zone's
+    // checks.
+    static void project(WGS84 wgs_84, double &E, double &N, int &number, char &letter);
+    static WGS84 unproject(double E, double N, double altitude, int number, char letter);
+    // The zone checks of parse_zone() on a number and a letter.
+    static bool valid_zone(int number, char letter);
+
     double E{};
     double N{};
     double altitude{};
@@ -113,6 +179,10 @@ class UTM {
     static constexpr double N0 = 10000000.0;
 
  private:
+    UTM(WGS84 wgs_84, GridFactors *factors);
+
+    static void project(WGS84 wgs_84, double &E, double &N, int &number, char &letter,
+                        GridFactors *factors);
     static char letter_designator(Degree latitude);
 };
 
@@ -120,10 +190,31 @@ class GaussKruger {
  public:
     GaussKruger() = default;
     explicit GaussKruger(SK42 sk_42);
+    GaussKruger(SK42 sk_42, GridFactors &factors);
+    // Also reports d(x, y)/d(B, L), carried through the series as dual
+    // numbers in the same pass.
+    GaussKruger(SK42 sk_42, Jacobian &jacobian);
+
+    // Projects into each of the given zones (1-60) instead of the zone that
+    // contains the point; the latitude terms are computed once for all zones.
+    // Throws std::invalid_argument for a zone outside 1-60.
+    static std::vector<GaussKruger> in_zones(SK42 sk_42, const std::vector<int> &zones);
+    // The same for one zone, without building any vector.
+    static GaussKruger in_zone(SK42 sk_42, int zone);
 
     double x;
     double y;
     double height;
+
+ private:
+    GaussKruger(SK42 sk_42, GridFactors *factors);
 };
 
+// Checks computed with comparisons only, so batch loops stay branch-free.
+// The WGS84 check also flags latitudes outside the UTM band range when
+// `for_utm` is set.
+std::uint8_t validate(const WGS84 &wgs_84, bool for_utm = false);
+std::uint8_t validate(const UTM &utm);
+std::uint8_t validate(const GaussKruger &gk);
+
 #endif  // TRANSFORMATION_LIB_TRANSFORMATIONS_H_
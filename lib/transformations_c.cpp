@@ -0,0 +1,200 @@
+#include "transformations_c.h"
+
+#include "transformations.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Strides need not be multiples of the alignment of T, so values are copied
+// bytewise rather than dereferenced in place.
+template <class T>
+T load(const transformations_column &column, size_t i) {
+    T value;
+    std::memcpy(&value, static_cast<const char *>(column.data) + column.stride * static_cast<ptrdiff_t>(i), sizeof(T));
+    return value;
+}
+
+template <class T>
+void store(const transformations_mutable_column &column, size_t i, T value) {
+    std::memcpy(static_cast<char *>(column.data) + column.stride * static_cast<ptrdiff_t>(i), &value, sizeof(T));
+}
+
+bool valid(const transformations_column &column) {
+    return column.data != nullptr;
+}
+bool valid(const transformations_mutable_column &column) {
+    return column.data != nullptr;
+}
+
+static_assert(TRANSFORMATIONS_STATUS_NON_FINITE == STATUS_NON_FINITE &&
+              TRANSFORMATIONS_STATUS_OUT_OF_RANGE == STATUS_OUT_OF_RANGE &&
+              TRANSFORMATIONS_STATUS_INVALID_ZONE == STATUS_INVALID_ZONE,
+              "C status flags must match STATUS");
+
+// Runs `convert_one` for every point, records its STATUS flags and keeps
+// exceptions from crossing the C boundary.
+template <class Convert>
+transformations_result convert(size_t count, uint8_t *status, Convert convert_one) {
+    try {
+        uint8_t any = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t flags = convert_one(i);
+            any |= flags;
+            if (status) {
+                status[i] = flags;
+            }
+        }
+        return any == 0 ? TRANSFORMATIONS_OK : TRANSFORMATIONS_INVALID_POINTS;
+    } catch (...) {
+        return TRANSFORMATIONS_INTERNAL_ERROR;
+    }
+}
+
+uint8_t non_finite(double a, double b, double c) {
+    return (std::isfinite(a) && std::isfinite(b) && std::isfinite(c)) ? STATUS_OK : STATUS_NON_FINITE;
+}
+
+uint8_t zone_status(int number, char letter) {
+    return UTM::valid_zone(number, letter) ? STATUS_OK : STATUS_INVALID_ZONE;
+}
+
+}  // namespace
+
+extern "C" {
+
+transformations_result transformations_wgs84_to_gauss_kruger(
+    size_t count,
+    transformations_column latitude, transformations_column longitude, transformations_column altitude,
+    transformations_mutable_column x, transformations_mutable_column y, transformations_mutable_column height,
+    uint8_t *status) {
+    if (!valid(latitude) || !valid(longitude) || !valid(altitude) || !valid(x) || !valid(y) || !valid(height)) {
+        return TRANSFORMATIONS_INVALID_ARGUMENT;
+    }
+    return convert(count, status, [&](size_t i) {
+        WGS84 wgs_84{Degree{load<double>(latitude, i)}, Degree{load<double>(longitude, i)}, load<double>(altitude, i)};
+        GaussKruger gk{SK42{wgs_84}};
+        store(x, i, gk.x);
+        store(y, i, gk.y);
+        store(height, i, gk.height);
+        return static_cast<uint8_t>(validate(wgs_84) | (validate(gk) & (STATUS_NON_FINITE | STATUS_INVALID_ZONE)));
+    });
+}
+
+transformations_result transformations_gauss_kruger_to_wgs84(
+    size_t count,
+    transformations_column x, transformations_column y, transformations_column height,
+    transformations_mutable_column latitude, transformations_mutable_column longitude,
+    transformations_mutable_column altitude,
+    uint8_t *status) {
+    if (!valid(x) || !valid(y) || !valid(height) || !valid(latitude) || !valid(longitude) || !valid(altitude)) {
+        return TRANSFORMATIONS_INVALID_ARGUMENT;
+    }
+    return convert(count, status, [&](size_t i) {
+        GaussKruger gk;
+        gk.x = load<double>(x, i);
+        gk.y = load<double>(y, i);
+        gk.height = load<double>(height, i);
+        WGS84 wgs_84{SK42{gk}};
+        store<double>(latitude, i, wgs_84.latitude);
+        store<double>(longitude, i, wgs_84.longitude);
+        store(altitude, i, wgs_84.altitude);
+        return static_cast<uint8_t>(validate(gk) | non_finite(wgs_84.latitude, wgs_84.longitude, wgs_84.altitude));
+    });
+}
+
+transformations_result transformations_wgs84_to_utm(
+    size_t count,
+    transformations_column latitude, transformations_column longitude, transformations_column altitude,
+    transformations_mutable_column E, transformations_mutable_column N, transformations_mutable_column utm_altitude,
+    transformations_mutable_column zone_number, transformations_mutable_column zone_letter,
+    uint8_t *status) {
+    if (!valid(latitude) || !valid(longitude) || !valid(altitude) || !valid(E) || !valid(N) ||
+        !valid(utm_altitude) || !valid(zone_number) || !valid(zone_letter)) {
+        return TRANSFORMATIONS_INVALID_ARGUMENT;
+    }
+    return convert(count, status, [&](size_t i) {
+        WGS84 wgs_84{Degree{load<double>(latitude, i)}, Degree{load<double>(longitude, i)}, load<double>(altitude, i)};
+        double utm_E = 0;
+        double utm_N = 0;
+        int number = 0;
+        char letter = 0;
+        UTM::project(wgs_84, utm_E, utm_N, number, letter);
+        store(E, i, utm_E);
+        store(N, i, utm_N);
+        store(utm_altitude, i, wgs_84.altitude);
+        store(zone_number, i, static_cast<int32_t>(number));
+        store(zone_letter, i, letter);
+        return static_cast<uint8_t>(validate(wgs_84, true) | non_finite(utm_E, utm_N, wgs_84.altitude) |
+                                    zone_status(number, letter));
+    });
+}
+
+transformations_result transformations_utm_to_wgs84(
+    size_t count,
+    transformations_column E, transformations_column N, transformations_column utm_altitude,
+    transformations_column zone_number, transformations_column zone_letter,
+    transformations_mutable_column latitude, transformations_mutable_column longitude,
+    transformations_mutable_column altitude,
+    uint8_t *status) {
+    if (!valid(E) || !valid(N) || !valid(utm_altitude) || !valid(zone_number) || !valid(zone_letter) ||
+        !valid(latitude) || !valid(longitude) || !valid(altitude)) {
+        return TRANSFORMATIONS_INVALID_ARGUMENT;
+    }
+    return convert(count, status, [&](size_t i) {
+        double utm_E = load<double>(E, i);
+        double utm_N = load<double>(N, i);
+        int32_t number = load<int32_t>(zone_number, i);
+        char letter = load<char>(zone_letter, i);
+        WGS84 wgs_84 = UTM::unproject(utm_E, utm_N, load<double>(utm_altitude, i), number, letter);
+        store<double>(latitude, i, wgs_84.latitude);
+        store<double>(longitude, i, wgs_84.longitude);
+        store(altitude, i, wgs_84.altitude);
+        return static_cast<uint8_t>(non_finite(utm_E, utm_N, wgs_84.altitude) | zone_status(number, letter) |
+                                    non_finite(wgs_84.latitude, wgs_84.longitude, wgs_84.altitude));
+    });
+}
+
+transformations_result transformations_pz90_to_wgs84(
+    size_t count,
+    transformations_column latitude, transformations_column longitude, transformations_column altitude,
+    transformations_mutable_column wgs84_latitude, transformations_mutable_column wgs84_longitude,
+    transformations_mutable_column wgs84_altitude,
+    uint8_t *status) {
+    if (!valid(latitude) || !valid(longitude) || !valid(altitude) || !valid(wgs84_latitude) ||
+        !valid(wgs84_longitude) || !valid(wgs84_altitude)) {
+        return TRANSFORMATIONS_INVALID_ARGUMENT;
+    }
+    return convert(count, status, [&](size_t i) {
+        PZ90 pz_90{Degree{load<double>(latitude, i)}, Degree{load<double>(longitude, i)}, load<double>(altitude, i)};
+        WGS84 wgs_84{pz_90};
+        store<double>(wgs84_latitude, i, wgs_84.latitude);
+        store<double>(wgs84_longitude, i, wgs_84.longitude);
+        store(wgs84_altitude, i, wgs_84.altitude);
+        WGS84 input{pz_90.latitude, pz_90.longitude, pz_90.altitude};
+        return static_cast<uint8_t>(validate(input) | non_finite(wgs_84.latitude, wgs_84.longitude, wgs_84.altitude));
+    });
+}
+
+transformations_result transformations_wgs84_to_pz90(
+    size_t count,
+    transformations_column latitude, transformations_column longitude, transformations_column altitude,
+    transformations_mutable_column pz90_latitude, transformations_mutable_column pz90_longitude,
+    transformations_mutable_column pz90_altitude,
+    uint8_t *status) {
+    if (!valid(latitude) || !valid(longitude) || !valid(altitude) || !valid(pz90_latitude) ||
+        !valid(pz90_longitude) || !valid(pz90_altitude)) {
+        return TRANSFORMATIONS_INVALID_ARGUMENT;
+    }
+    return convert(count, status, [&](size_t i) {
+        WGS84 wgs_84{Degree{load<double>(latitude, i)}, Degree{load<double>(longitude, i)}, load<double>(altitude, i)};
+        PZ90 pz_90{wgs_84};
+        store<double>(pz90_latitude, i, pz_90.latitude);
+        store<double>(pz90_longitude, i, pz_90.longitude);
+        store(pz90_altitude, i, pz_90.altitude);
+        return static_cast<uint8_t>(validate(wgs_84) | non_finite(pz_90.latitude, pz_90.longitude, pz_90.altitude));
+    });
+}
+
+}  // extern "C"
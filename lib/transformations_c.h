@@ -0,0 +1,95 @@
+#ifndef TRANSFORMATION_LIB_TRANSFORMATIONS_C_H_
+#define TRANSFORMATION_LIB_TRANSFORMATIONS_C_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* TRANSFORMATIONS_C_BUILD is defined only while building the library itself. */
+#if defined(_WIN32) && defined(TRANSFORMATIONS_C_BUILD)
+#define TRANSFORMATIONS_C_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define TRANSFORMATIONS_C_API __declspec(dllimport)
+#else
+#define TRANSFORMATIONS_C_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* C interface of the batch conversions for FFI callers. Every column is a
+ * pointer plus a stride in bytes, so numpy arrays, Go slices and fields of
+ * interleaved structs can be passed without copying. The functions keep no
+ * global state and do not allocate, so they may be called from any number of
+ * threads at once. `status` may be NULL; otherwise it receives one entry per
+ * point holding the TRANSFORMATIONS_STATUS_* flags below (0 for a good point). */
+
+#define TRANSFORMATIONS_STATUS_NON_FINITE 1
+#define TRANSFORMATIONS_STATUS_OUT_OF_RANGE 2
+#define TRANSFORMATIONS_STATUS_INVALID_ZONE 4
+
+typedef enum {
+    TRANSFORMATIONS_OK = 0,
+    TRANSFORMATIONS_INVALID_ARGUMENT = 1,
+    TRANSFORMATIONS_INVALID_POINTS = 2, /* at least one status entry is not 0 */
+    TRANSFORMATIONS_INTERNAL_ERROR = 3
+} transformations_result;
+
+typedef struct {
+    const void *data;
+    ptrdiff_t stride;
+} transformations_column;
+
+typedef struct {
+    void *data;
+    ptrdiff_t stride;
+} transformations_mutable_column;
+
+TRANSFORMATIONS_C_API transformations_result transformations_wgs84_to_gauss_kruger(
+    size_t count,
+    transformations_column latitude, transformations_column longitude, transformations_column altitude,
+    transformations_mutable_column x, transformations_mutable_column y, transformations_mutable_column height,
+    uint8_t *status);
+
+TRANSFORMATIONS_C_API transformations_result transformations_gauss_kruger_to_wgs84(
+    size_t count,
+    transformations_column x, transformations_column y, transformations_column height,
+    transformations_mutable_column latitude, transformations_mutable_column longitude,
+    transformations_mutable_column altitude,
+    uint8_t *status);
+
+/* UTM zones are passed as an int32 zone number column and a char band letter column. */
+TRANSFORMATIONS_C_API transformations_result transformations_wgs84_to_utm(
+    size_t count,
+    transformations_column latitude, transformations_column longitude, transformations_column altitude,
+    transformations_mutable_column E, transformations_mutable_column N, transformations_mutable_column utm_altitude,
+    transformations_mutable_column zone_number, transformations_mutable_column zone_letter,
+    uint8_t *status);
+
+TRANSFORMATIONS_C_API transformations_result transformations_utm_to_wgs84(
+    size_t count,
+    transformations_column E, transformations_column N, transformations_column utm_altitude,
+    transformations_column zone_number, transformations_column zone_letter,
+    transformations_mutable_column latitude, transformations_mutable_column longitude,
+    transformations_mutable_column altitude,
+    uint8_t *status);
+
+TRANSFORMATIONS_C_API transformations_result transformations_pz90_to_wgs84(
+    size_t count,
+    transformations_column latitude, transformations_column longitude, transformations_column altitude,
+    transformations_mutable_column wgs84_latitude, transformations_mutable_column wgs84_longitude,
+    transformations_mutable_column wgs84_altitude,
+    uint8_t *status);
+
+TRANSFORMATIONS_C_API transformations_result transformations_wgs84_to_pz90(
+    size_t count,
+    transformations_column latitude, transformations_column longitude, transformations_column altitude,
+    transformations_mutable_column pz90_latitude, transformations_mutable_column pz90_longitude,
+    transformations_mutable_column pz90_altitude,
+    uint8_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TRANSFORMATION_LIB_TRANSFORMATIONS_C_H_
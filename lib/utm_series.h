@@ -0,0 +1,70 @@
+#ifndef TRANSFORMATION_LIB_UTM_SERIES_H_
+#define TRANSFORMATION_LIB_UTM_SERIES_H_
+
+#include "transformations.h"
+
+#include <limits>
+
+// Constants of the UTM series on the WGS84 class ellipsoid, all evaluated at
+// compile time. tests/utm_series checks each against the runtime expression
+// it replaced, bit for bit.
+namespace utm_series {
+
+// x - r * r, exact but for the final rounding: r * r is split into the
+// rounded product and its error with Dekker's method.
+constexpr double split_high(double r) {
+    return 134217729.0 * r - (134217729.0 * r - r);
+}
+constexpr double residual(double x, double r, double high) {
+    return (x - r * r) - (((high * high - r * r) + 2 * high * (r - high)) + (r - high) * (r - high));
+}
+constexpr double magnitude(double x) {
+    return x < 0 ? -x : x;
+}
+// Of two roots, the one whose square is closer to x.
+constexpr double closer(double x, double a, double b) {
+    return magnitude(residual(x, a, split_high(a))) <= magnitude(residual(x, b, split_high(b))) ? a : b;
+}
+// Neighbouring doubles of an r near 1; the spacing halves below 1.
+constexpr double below(double r) {
+    return r - (r <= 1 ? 0.5 : 1) * std::numeric_limits<double>::epsilon();
+}
+constexpr double above(double r) {
+    return r + (r < 1 ? 0.5 : 1) * std::numeric_limits<double>::epsilon();
+}
+
+// Correctly rounded square root of x near 1, the only arguments it is used
+// for. Newton's iteration from 1 settles within eight steps but can end one
+// unit in the last place off; the closest of the result and its neighbours
+// is the rounded root.
+constexpr double sqrt_near_one(double x, double r = 1, int steps = 8) {
+    return steps == 0 ? closer(x, closer(x, below(r), r), above(r))
+                      : sqrt_near_one(x, (r + x / r) / 2, steps - 1);
+}
+
+constexpr double e4 = WGS84::_e2 * WGS84::_e2;
+constexpr double e6 = e4 * WGS84::_e2;
+constexpr double ep2 = WGS84::_e2 / (1 - WGS84::_e2);
+// Forward UTM series.
+constexpr double m0 = 1 - WGS84::_e2 / 4 - (3. / 64) * e4 - (5. / 256) * e6;
+constexpr double m2 = (3. / 8) * WGS84::_e2 + (3. / 32) * e4 + (45. / 1024) * e6;
+constexpr double m4 = (15. / 256) * e4 + (45. / 1024) * e6;
+constexpr double m6 = (35. / 3072) * e6;
+// Inverse UTM series: rectifying radius and footpoint latitude.
+constexpr double mu_scale = WGS84::_a * (1 - WGS84::_e2 / 4 - 3 * WGS84::_e2 * WGS84::_e2 / 64
+    - 5 * WGS84::_e2 * WGS84::_e2 * WGS84::_e2 / 256);
+constexpr double root = sqrt_near_one(1 - WGS84::_e2);
+constexpr double e1 = (1 - root) / (1 + root);
+constexpr double phi2 = 3 * e1 / 2 - (27. / 32) * (e1 * e1 * e1) / 32;
+constexpr double phi4 = (21. / 16) * (e1 * e1) - (55. / 32) * (e1 * e1 * e1 * e1);
+constexpr double phi6 = (151. / 96) * (e1 * e1 * e1);
+
+// The root is within half a unit in the last place (eps / 2 below 1) of
+// sqrt(1 - e^2), so e1 equals the libm expression it replaced.
+static_assert(magnitude(residual(1 - WGS84::_e2, root, split_high(root))) <=
+                  root * std::numeric_limits<double>::epsilon() / 2,
+              "the root behind e1 is not correctly rounded");
+
+}  // namespace utm_series
+
+#endif  // TRANSFORMATION_LIB_UTM_SERIES_H_
@@ -1,17 +1,82 @@
-#include "transformations.h"
+#include "route.h"
 
 #include <iostream>
+#include <string>
+
+namespace {
+
+double read_value(const char *prompt) {
+    std::cout << prompt;
+    double value{};
+    std::cin >> value;
+    return value;
+}
+
+// Zone such as "37U"; an unparsable one reads as zone 0, which converts to
+// NaN like any other invalid zone.
+std::int32_t read_zone(char &letter) {
+    std::cout << "Zone: ";
+    std::string zone;
+    std::cin >> zone;
+    int number = 0;
+    if (!UTM::parse_zone(zone, number, letter)) {
+        number = 0;
+    }
+    return number;
+}
+
+Coordinates read_point(CRS crs) {
+    Coordinates point{};
+    switch (crs) {
+        case CRS::GAUSS_KRUGER:
+            point.values[0] = read_value("x: ");
+            point.values[1] = read_value("y: ");
+            point.values[2] = read_value("height: ");
+            break;
+        case CRS::UTM:
+            point.values[0] = read_value("Easting: ");
+            point.values[1] = read_value("Northing: ");
+            point.values[2] = read_value("altitude: ");
+            point.zone_number = read_zone(point.zone_letter);
+            break;
+        default:
+            point.values[0] = read_value("latitude: ");
+            point.values[1] = read_value("longitude: ");
+            point.values[2] = read_value("altitude: ");
+    }
+    return point;
+}
+
+void print_point(CRS crs, const Coordinates &point) {
+    switch (crs) {
+        case CRS::GAUSS_KRUGER:
+            std::cout << "x: " << point.values[0] << " y: " << point.values[1] << std::endl;
+            break;
+        case CRS::UTM:
+            std::cout << "Easting: " << point.values[0] << " Northing: " << point.values[1]
+                      << " Zone: " << point.zone_number << point.zone_letter << std::endl;
+            break;
+        default:
+            std::cout << "latitude: " << point.values[0] << " longitude: " << point.values[1] << std::endl;
+    }
+}
+
+}  // namespace
 
 int main() {
-    enum COMMAND {
-        FromWGS84ToGaussKruger = 1,
-        FromGaussKrugerToWGS84 = 2,
-        FromPZ90ToGaussKruger = 3,
-        FromGaussKrugerToPZ90 = 4,
-        FromWGS84ToUTM = 5,
-        FromUTMToWGS84 = 6,
-        FromPZ90ToUTM = 7,
-        FromUTMToPZ90 = 8
+    struct Command {
+        CRS from;
+        CRS to;
+    };
+    const Command commands[] = {
+        {CRS::WGS84, CRS::GAUSS_KRUGER},
+        {CRS::GAUSS_KRUGER, CRS::WGS84},
+        {CRS::PZ90, CRS::GAUSS_KRUGER},
+        {CRS::GAUSS_KRUGER, CRS::PZ90},
+        {CRS::WGS84, CRS::UTM},
+        {CRS::UTM, CRS::WGS84},
+        {CRS::PZ90, CRS::UTM},
+        {CRS::UTM, CRS::PZ90}
     };
     std::cout << "enter command:\n"
                  "1: FromWGS84ToGaussKruger\n"
@@ -26,162 +91,14 @@ int main() {
     int command = 0;
     std::cout.precision(9);
     while (std::cin >> command) {
-        switch (command) {
-            case FromWGS84ToGaussKruger: {
-                std::cout << "latitude: ";
-                double latitude{};
-                std::cin >> latitude;
-
-                std::cout << "longitude: ";
-                double longitude{};
-                std::cin >> longitude;
-
-                std::cout << "altitude: ";
-                double altitude{};
-                std::cin >> altitude;
-
-                WGS84 wgs_84{Degree{latitude}, Degree{longitude}, altitude};
-                GaussKruger gk{SK42{wgs_84}};
-
-                std::cout << "x: " << gk.x << " y: " << gk.y << std::endl;
-                break;
-            }
-            case FromGaussKrugerToWGS84: {
-                GaussKruger gk{};
-                std::cout << "x: ";
-                std::cin >> gk.x;
-                std::cout << "y: ";
-                std::cin >> gk.y;
-                std::cout << "height: ";
-                std::cin >> gk.height;
-
-                WGS84 wgs_84{SK42{gk}};
-
-                std::cout << "latitude: " << wgs_84.latitude << " longitude: " << wgs_84.longitude << std::endl;
-                break;
-            }
-            case FromPZ90ToGaussKruger: {
-                std::cout << "latitude: ";
-                double latitude{};
-                std::cin >> latitude;
-
-                std::cout << "longitude: ";
-                double longitude{};
-                std::cin >> longitude;
-
-                std::cout << "altitude: ";
-                double altitude{};
-                std::cin >> altitude;
-
-                PZ90 pz_90{Degree{latitude}, Degree{longitude}, altitude};
-                GaussKruger gk{SK42{WGS84{pz_90}}};
-
-                std::cout << "x: " << gk.x << " y: " << gk.y << std::endl;
-                break;
-            }
-            case FromGaussKrugerToPZ90: {
-                GaussKruger gk{};
-                std::cout << "x: ";
-                std::cin >> gk.x;
-                std::cout << "y: ";
-                std::cin >> gk.y;
-                std::cout << "height: ";
-                std::cin >> gk.height;
-
-                PZ90 pz_90{WGS84{SK42{gk}}};
-
-                std::cout << "latitude: " << pz_90.latitude << " longitude: " << pz_90.longitude << std::endl;
-                break;
-            }
-            case FromWGS84ToUTM: {
-                std::cout << "latitude: ";
-                double latitude{};
-                std::cin >> latitude;
-
-                std::cout << "longitude: ";
-                double longitude{};
-                std::cin >> longitude;
-
-                std::cout << "altitude: ";
-                double altitude{};
-                std::cin >> altitude;
-
-                WGS84 wgs_84{Degree{latitude}, Degree{longitude}, altitude};
-                UTM utm{wgs_84};
-
-                std::cout << "Easting: " << utm.E << " Northing: " << utm.N << " Zone: " << utm.zone
-                          << std::endl;
-                break;
-            }
-            case FromUTMToWGS84: {
-                std::cout << "Easting: ";
-                double E{};
-                std::cin >> E;
-
-                std::cout << "Northing: ";
-                double N{};
-                std::cin >> N;
-
-                std::cout << "altitude: ";
-                double altitude{};
-                std::cin >> altitude;
-
-                std::cout << "Zone: ";
-                std::string zone;
-                std::cin >> zone;
-
-                UTM utm{Degree{E}, Degree{N}, altitude, zone};
-                WGS84 wgs_84{utm};
-
-                std::cout << "latitude: " << wgs_84.latitude << " longitude: " << wgs_84.longitude << std::endl;
-                break;
-            }
-            case FromPZ90ToUTM: {
-                std::cout << "latitude: ";
-                double latitude{};
-                std::cin >> latitude;
-
-                std::cout << "longitude: ";
-                double longitude{};
-                std::cin >> longitude;
-
-                std::cout << "altitude: ";
-                double altitude{};
-                std::cin >> altitude;
-
-                PZ90 pz_90{Degree{latitude}, Degree{longitude}, altitude};
-                UTM utm{WGS84{pz_90}};
-
-                std::cout << "Easting: " << utm.E << " Northing: " << utm.N << " Zone: " << utm.zone
-                          << std::endl;
-                break;
-            }
-            case FromUTMToPZ90: {
-                std::cout << "Easting: ";
-                double E{};
-                std::cin >> E;
-
-                std::cout << "Northing: ";
-                double N{};
-                std::cin >> N;
-
-                std::cout << "altitude: ";
-                double altitude{};
-                std::cin >> altitude;
-
-                std::cout << "Zone: ";
-                std::string zone;
-                std::cin >> zone;
-
-                UTM utm{Degree{E}, Degree{N}, altitude, zone};
-                PZ90 pz_90{WGS84{utm}};
-
-                std::cout << "latitude: " << pz_90.latitude << " longitude: " << pz_90.longitude << std::endl;
-                break;
-            }
-            default:
-                std::cout << "wrong command" << std::endl;
+        if (command < 1 || command > 8) {
+            std::cout << "wrong command" << std::endl;
+            continue;
         }
+        const Command &selected = commands[command - 1];
+        Coordinates point = read_point(selected.from);
+        route(selected.from, selected.to)(&point, 1);
+        print_point(selected.to, point);
     }
     return 0;
 }
@@ -0,0 +1,61 @@
+#include "async_batch.h"
+#include "batch.h"
+#include "check.h"
+
+#include <mutex>
+
+namespace {
+
+std::vector<WGS84> points(std::size_t count) {
+    std::vector<WGS84> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(WGS84{Degree{40 + i * 0.001}, Degree{20 + i * 0.002}, 100});
+    }
+    return result;
+}
+
+}  // namespace
+
+int main() {
+    std::vector<UTM> expected = to_utm(points(1000));
+
+    // Chunks arrive in order and together equal the synchronous result.
+    std::vector<UTM> received;
+    bool completed = false;
+    {
+        ConversionJob job = convert_async<UTM>(
+            points(1000), to_utm, 64,
+            [&](std::size_t offset, std::vector<UTM> chunk) {
+                check(offset == received.size(), "chunk offset");
+                received.insert(received.end(), chunk.begin(), chunk.end());
+            },
+            [&](bool done) { completed = done; });
+    }
+    check(completed, "job completed");
+    check(received.size() == expected.size(), "all points converted");
+    bool same = received.size() == expected.size();
+    for (std::size_t i = 0; same && i < received.size(); ++i) {
+        same = received[i].E == expected[i].E && received[i].N == expected[i].N;
+    }
+    check(same, "chunks match the synchronous conversion");
+
+    // Cancelling from a chunk callback stops before the next chunk.
+    std::size_t chunks = 0;
+    bool cancelled = false;
+    std::mutex mutex;
+    std::unique_lock<std::mutex> hold(mutex);
+    ConversionJob job = convert_async<UTM>(
+        points(1000), to_utm, 100,
+        [&](std::size_t, std::vector<UTM>) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ++chunks;
+        },
+        [&](bool done) { cancelled = !done; });
+    job.cancel();
+    hold.unlock();
+    job.wait();
+    check(cancelled, "cancelled job reports false");
+    check(chunks <= 1, "at most the chunk in flight after cancel");
+
+    return report();
+}
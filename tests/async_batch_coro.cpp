@@ -0,0 +1,84 @@
+#include "async_batch_coro.h"
+#include "batch.h"
+#include "check.h"
+
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+
+namespace {
+
+// Coroutine that starts at once and signals when it returns.
+struct Task {
+    struct promise_type {
+        Task get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+struct Latch {
+    std::mutex mutex;
+    std::condition_variable signal;
+    bool done = false;
+
+    void open() {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        signal.notify_all();
+    }
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        signal.wait(lock, [this] { return done; });
+    }
+};
+
+std::vector<WGS84> points(std::size_t count) {
+    std::vector<WGS84> result;
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(WGS84{Degree{40 + i * 0.001}, Degree{20 + i * 0.002}, 100});
+    }
+    return result;
+}
+
+Task collect(ConversionStream<UTM, WGS84> &stream, std::vector<UTM> &received, std::size_t stop_after,
+             Latch &latch) {
+    std::size_t chunks = 0;
+    while (auto chunk = co_await stream.next()) {
+        check(chunk->offset == received.size(), "chunk offset");
+        received.insert(received.end(), chunk->points.begin(), chunk->points.end());
+        if (++chunks == stop_after) {
+            stream.cancel();
+        }
+    }
+    latch.open();
+}
+
+}  // namespace
+
+int main() {
+    std::vector<UTM> expected = to_utm(points(1000));
+
+    ConversionStream<UTM, WGS84> stream(points(1000), to_utm, 64);
+    std::vector<UTM> received;
+    Latch latch;
+    collect(stream, received, 0, latch);
+    latch.wait();
+    bool same = received.size() == expected.size();
+    for (std::size_t i = 0; same && i < received.size(); ++i) {
+        same = received[i].E == expected[i].E && received[i].N == expected[i].N;
+    }
+    check(same, "chunks match the synchronous conversion");
+
+    ConversionStream<UTM, WGS84> cancelled(points(1000), to_utm, 100);
+    std::vector<UTM> partial;
+    Latch cancelled_latch;
+    collect(cancelled, partial, 3, cancelled_latch);
+    cancelled_latch.wait();
+    check(partial.size() == 300, "cancel stops before the next chunk");
+
+    return report();
+}
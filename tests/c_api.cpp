@@ -0,0 +1,136 @@
+#include "batch.h"
+#include "check.h"
+#include "transformations_c.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// An interleaved record, so every column has a stride other than its size.
+struct Record {
+    double latitude;
+    double longitude;
+    double altitude;
+    std::int32_t zone_number;
+    char zone_letter;
+};
+
+bool same(double a, double b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+transformations_column in_column(const void *data, std::ptrdiff_t stride) {
+    return transformations_column{data, stride};
+}
+
+transformations_mutable_column out_column(void *data, std::ptrdiff_t stride) {
+    return transformations_mutable_column{data, stride};
+}
+
+}  // namespace
+
+int main() {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<WGS84> points{WGS84{Degree{55.75}, Degree{37.62}, 150}, WGS84{Degree{-33.86}, Degree{151.21}, 20},
+                              WGS84{Degree{64.1}, Degree{-21.9}, 5},    WGS84{Degree{nan}, Degree{10}, 0},
+                              WGS84{Degree{86}, Degree{10}, 0},         WGS84{Degree{10}, Degree{180}, 0}};
+    std::vector<Record> records;
+    for (const WGS84 &point : points) {
+        records.push_back(Record{point.latitude, point.longitude, point.altitude, 0, 0});
+    }
+    const std::ptrdiff_t stride = sizeof(Record);
+
+    // WGS84 -> UTM written back into the same records, against the batch API.
+    std::vector<std::uint8_t> status(points.size());
+    std::vector<double> E(points.size()), N(points.size()), height(points.size());
+    transformations_result result = transformations_wgs84_to_utm(
+        points.size(), in_column(&records[0].latitude, stride), in_column(&records[0].longitude, stride),
+        in_column(&records[0].altitude, stride), out_column(E.data(), sizeof(double)),
+        out_column(N.data(), sizeof(double)), out_column(height.data(), sizeof(double)),
+        out_column(&records[0].zone_number, stride), out_column(&records[0].zone_letter, stride),
+        status.data());
+    std::vector<std::uint8_t> expected_status;
+    std::vector<UTM> expected = to_utm(points, expected_status);
+    check(result == TRANSFORMATIONS_INVALID_POINTS, "flagged points give TRANSFORMATIONS_INVALID_POINTS");
+    check(status == expected_status, "UTM status matches the batch API");
+    check(status[0] == 0 && status[3] & TRANSFORMATIONS_STATUS_NON_FINITE &&
+          status[4] & TRANSFORMATIONS_STATUS_OUT_OF_RANGE && status[5] == TRANSFORMATIONS_STATUS_INVALID_ZONE,
+          "NaN, polar and longitude 180 points are flagged");
+    bool matches = true;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        int number = 0;
+        char letter = 0;
+        UTM::parse_zone(expected[i].zone, number, letter);
+        matches = matches && same(E[i], expected[i].E) && same(N[i], expected[i].N) && height[i] == points[i].altitude;
+        matches = matches && (i == 3 || (records[i].zone_number == number && records[i].zone_letter == letter));
+    }
+    check(matches, "strided UTM output matches the batch API");
+
+    // And back, reading the columns in reverse through a negative stride.
+    std::vector<double> latitude(points.size()), longitude(points.size()), altitude(points.size());
+    std::size_t last = points.size() - 1;
+    result = transformations_utm_to_wgs84(
+        points.size(), in_column(&E[last], -8), in_column(&N[last], -8), in_column(&height[last], -8),
+        in_column(&records[last].zone_number, -stride), in_column(&records[last].zone_letter, -stride),
+        out_column(latitude.data(), sizeof(double)), out_column(longitude.data(), sizeof(double)),
+        out_column(altitude.data(), sizeof(double)), status.data());
+    std::vector<UTM> reversed(expected.rbegin(), expected.rend());
+    std::vector<WGS84> expected_wgs84 = to_wgs84(reversed, expected_status);
+    check(result == TRANSFORMATIONS_INVALID_POINTS && status == expected_status,
+          "UTM -> WGS84 status matches the batch API");
+    matches = true;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        matches = matches && same(latitude[i], expected_wgs84[i].latitude) &&
+                  same(longitude[i], expected_wgs84[i].longitude);
+    }
+    check(matches, "negative strides read the columns backwards");
+
+    // A zone the C caller made up is flagged, not parsed leniently.
+    std::int32_t bad_number[] = {37, 0, 61, 37};
+    char bad_letter[] = {'U', 'U', 'U', 'I'};
+    double value[] = {500000, 500000, 500000, 500000};
+    std::uint8_t zone_status[4];
+    result = transformations_utm_to_wgs84(4, in_column(value, 8), in_column(value, 8), in_column(value, 8),
+                                          in_column(bad_number, 4), in_column(bad_letter, 1),
+                                          out_column(latitude.data(), 8), out_column(longitude.data(), 8),
+                                          out_column(altitude.data(), 8), zone_status);
+    bool flagged = true;
+    for (int i = 1; i < 4; ++i) {
+        flagged = flagged && (zone_status[i] & TRANSFORMATIONS_STATUS_INVALID_ZONE);
+    }
+    check(result == TRANSFORMATIONS_INVALID_POINTS && zone_status[0] == 0 && flagged,
+          "invalid zone numbers and letters");
+
+    // Gauss-Kruger flags results outside the zones as the batch API does.
+    std::vector<double> x(points.size()), y(points.size());
+    result = transformations_wgs84_to_gauss_kruger(
+        points.size(), in_column(&records[0].latitude, stride), in_column(&records[0].longitude, stride),
+        in_column(&records[0].altitude, stride), out_column(x.data(), 8), out_column(y.data(), 8),
+        out_column(height.data(), 8), status.data());
+    to_gauss_kruger(points, expected_status);
+    check(result == TRANSFORMATIONS_INVALID_POINTS && status == expected_status,
+          "Gauss-Kruger status matches the batch API");
+
+    // Good points only: TRANSFORMATIONS_OK, and status may be NULL.
+    result = transformations_wgs84_to_pz90(
+        3, in_column(&records[0].latitude, stride), in_column(&records[0].longitude, stride),
+        in_column(&records[0].altitude, stride), out_column(latitude.data(), 8), out_column(longitude.data(), 8),
+        out_column(altitude.data(), 8), nullptr);
+    PZ90 pz_90{points[1]};
+    check(result == TRANSFORMATIONS_OK && latitude[1] == pz_90.latitude && longitude[1] == pz_90.longitude,
+          "good points convert with a NULL status");
+
+    result = transformations_pz90_to_wgs84(3, in_column(nullptr, 8), in_column(value, 8), in_column(value, 8),
+                                           out_column(x.data(), 8), out_column(y.data(), 8),
+                                           out_column(height.data(), 8), nullptr);
+    check(result == TRANSFORMATIONS_INVALID_ARGUMENT, "a NULL column is an invalid argument");
+    result = transformations_gauss_kruger_to_wgs84(0, in_column(value, 8), in_column(value, 8), in_column(value, 8),
+                                                   out_column(x.data(), 8), out_column(y.data(), 8),
+                                                   out_column(height.data(), 8), nullptr);
+    check(result == TRANSFORMATIONS_OK, "an empty batch is fine");
+
+    return report();
+}
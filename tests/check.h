@@ -0,0 +1,28 @@
+#ifndef TRANSFORMATION_TESTS_CHECK_H_
+#define TRANSFORMATION_TESTS_CHECK_H_
+
+#include <cstdio>
+
+// Minimal test harness: check() prints each failed condition, and main()
+// ends with `return report();`, which prints "ok" when nothing failed.
+
+inline int &failures() {
+    static int count = 0;
+    return count;
+}
+
+inline void check(bool condition, const char *what) {
+    if (!condition) {
+        std::printf("FAILED: %s\n", what);
+        ++failures();
+    }
+}
+
+inline int report() {
+    if (failures() == 0) {
+        std::printf("ok\n");
+    }
+    return failures() == 0 ? 0 : 1;
+}
+
+#endif  // TRANSFORMATION_TESTS_CHECK_H_
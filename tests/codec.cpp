@@ -0,0 +1,98 @@
+#include "check.h"
+#include "codec.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+// A WGS84 stream of two points whose latitude deltas are both INT64_MAX:
+// accumulating them overflows a signed 64-bit integer.
+std::vector<std::uint8_t> overflowing_stream() {
+    std::vector<std::uint8_t> bytes{'T', 'C', '1', 1, 2};
+    // Zig-zag code of INT64_MAX, 2^64 - 2, as a ten-byte varint.
+    std::vector<std::uint8_t> largest{0xfe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01};
+    bytes.push_back(20);
+    bytes.insert(bytes.end(), largest.begin(), largest.end());
+    bytes.insert(bytes.end(), largest.begin(), largest.end());
+    for (int column = 0; column < 2; ++column) {
+        bytes.push_back(2);
+        bytes.push_back(0);
+        bytes.push_back(0);
+    }
+    return bytes;
+}
+
+bool same(double a, double b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+}  // namespace
+
+int main() {
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<WGS84> track;
+    for (int i = 0; i < 500; ++i) {
+        track.push_back(WGS84{Degree{55.75 + i * 1e-5}, Degree{37.62 - i * 2e-5}, 150 + i * 0.25});
+    }
+    track.push_back(WGS84{Degree{nan}, Degree{1e300}, std::numeric_limits<double>::infinity()});
+    track.push_back(WGS84{Degree{-33.86}, Degree{151.21}, -12.5});
+
+    std::vector<WGS84> decoded;
+    std::vector<std::uint8_t> bytes = encode(track);
+    check(decode(bytes, decoded) && decoded.size() == track.size(), "WGS84 round trip");
+    bool close = true;
+    for (std::size_t i = 0; i < track.size() && i < decoded.size(); ++i) {
+        if (i == 500) {
+            close = close && std::isnan(decoded[i].latitude) && std::isnan(decoded[i].longitude) &&
+                    std::isnan(decoded[i].altitude);
+            continue;
+        }
+        close = close && std::fabs(decoded[i].latitude - track[i].latitude) <= 0.5e-8 &&
+                std::fabs(decoded[i].longitude - track[i].longitude) <= 0.5e-8 &&
+                std::fabs(decoded[i].altitude - track[i].altitude) <= 0.5e-3;
+    }
+    check(close, "WGS84 values within the fixed-point step; out-of-range values decode as NaN");
+    check(bytes.size() < track.size() * 8, "a smooth track encodes in under 8 bytes per point");
+
+    // Transcoding matches converting the decoded points.
+    std::vector<std::uint8_t> utm_bytes;
+    std::vector<UTM> utm;
+    check(transcode_to_utm(bytes, utm_bytes) && decode(utm_bytes, utm) && utm.size() == track.size(),
+          "UTM transcode round trip");
+    bool zones = true;
+    for (std::size_t i = 0; i < utm.size(); ++i) {
+        UTM expected{decoded[i]};
+        zones = zones && utm[i].zone == expected.zone && (i == 500 || std::fabs(utm[i].E - expected.E) <= 0.5e-3);
+    }
+    check(zones, "UTM transcode keeps zones and eastings");
+    std::vector<std::uint8_t> gk_bytes;
+    std::vector<GaussKruger> gk;
+    check(transcode_to_gauss_kruger(bytes, gk_bytes) && decode(gk_bytes, gk) && gk.size() == track.size(),
+          "Gauss-Kruger transcode round trip");
+    check(same(gk[500].x, nan), "Gauss-Kruger keeps missing values missing");
+
+    // Every truncation and the wrong kind are rejected.
+    bool truncated = true;
+    for (std::size_t size = 0; size < bytes.size(); ++size) {
+        std::vector<std::uint8_t> prefix(bytes.begin(), bytes.begin() + size);
+        truncated = truncated && !decode(prefix, decoded);
+    }
+    check(truncated, "truncated streams are rejected");
+    check(!decode(bytes, gk), "a WGS84 stream does not decode as Gauss-Kruger");
+
+    check(!decode(overflowing_stream(), decoded), "deltas overflowing the fixed-point range are rejected");
+
+    // Flipped bytes may decode to other values but never crash or overrun.
+    std::size_t accepted = 0;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        std::vector<std::uint8_t> corrupt = bytes;
+        corrupt[i] ^= 0xa5;
+        accepted += decode(corrupt, decoded);
+    }
+    check(accepted < bytes.size(), "most corrupt streams are rejected");
+
+    return report();
+}
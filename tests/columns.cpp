@@ -0,0 +1,120 @@
+#include "check.h"
+#include "columns.h"
+#include "transformations.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+bool same(double a, double b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+bool bit(const std::vector<std::uint8_t> &bitmap, std::size_t i) {
+    return (bitmap[i / 8] >> (i % 8)) & 1;
+}
+
+void set_bit(std::vector<std::uint8_t> &bitmap, std::size_t i, bool value) {
+    if (value) {
+        bitmap[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+    } else {
+        bitmap[i / 8] &= static_cast<std::uint8_t>(~(1u << (i % 8)));
+    }
+}
+
+}  // namespace
+
+int main() {
+    // Rows are slices of longer arrays at offsets that are not a multiple of 8,
+    // with nulls on both sides of each byte boundary.
+    const std::size_t length = 21;
+    const std::size_t latitude_offset = 5;
+    const std::size_t longitude_offset = 11;
+    const std::size_t altitude_offset = 3;
+    std::vector<double> latitude(latitude_offset + length + 4, -1.0);
+    std::vector<double> longitude(longitude_offset + length, -1.0);
+    std::vector<double> altitude(altitude_offset + length, -1.0);
+    std::vector<std::uint8_t> latitude_validity((latitude_offset + length + 7) / 8, 0xff);
+    std::vector<std::uint8_t> longitude_validity((longitude_offset + length + 7) / 8, 0xff);
+    std::vector<bool> expected_valid(length);
+    for (std::size_t i = 0; i < length; ++i) {
+        latitude[latitude_offset + i] = -60 + 6.0 * i;
+        longitude[longitude_offset + i] = -175 + 17.0 * i;
+        altitude[altitude_offset + i] = 10.0 * i;
+        bool latitude_valid = i % 3 != 1;
+        bool longitude_valid = i % 7 != 2;
+        set_bit(latitude_validity, latitude_offset + i, latitude_valid);
+        set_bit(longitude_validity, longitude_offset + i, longitude_valid);
+        expected_valid[i] = latitude_valid && longitude_valid;
+    }
+    // Rows outside the slice are null too, so a misaligned read shows up.
+    set_bit(latitude_validity, latitude_offset - 1, false);
+    set_bit(latitude_validity, latitude_offset + length, false);
+
+    DoubleColumn latitude_column{latitude.data(), latitude_validity.data(), latitude_offset};
+    DoubleColumn longitude_column{longitude.data(), longitude_validity.data(), longitude_offset};
+    DoubleColumn altitude_column{altitude.data(), nullptr, altitude_offset};
+
+    std::vector<double> E(length), N(length), utm_altitude(length);
+    std::vector<std::uint8_t> E_validity((length + 7) / 8), N_validity((length + 7) / 8);
+    std::vector<std::int32_t> zone_number(length);
+    std::vector<char> zone_letter(length);
+    to_utm(length, latitude_column, longitude_column, altitude_column,
+           MutableDoubleColumn{E.data(), E_validity.data()}, MutableDoubleColumn{N.data(), N_validity.data()},
+           MutableDoubleColumn{utm_altitude.data(), nullptr}, zone_number.data(), zone_letter.data());
+
+    bool values = true;
+    bool validity = true;
+    for (std::size_t i = 0; i < length; ++i) {
+        UTM expected{WGS84{Degree{latitude[latitude_offset + i]}, Degree{longitude[longitude_offset + i]},
+                           altitude[altitude_offset + i]}};
+        int number = 0;
+        char letter = 0;
+        UTM::parse_zone(expected.zone, number, letter);
+        values = values && same(E[i], expected.E) && same(N[i], expected.N) &&
+                 same(utm_altitude[i], expected.altitude) && zone_number[i] == number && zone_letter[i] == letter;
+        validity = validity && bit(E_validity, i) == expected_valid[i] && bit(N_validity, i) == expected_valid[i];
+    }
+    check(values, "UTM columns read the rows at their offsets");
+    check(validity, "UTM validity is the AND of the realigned input bitmaps");
+
+    // And back, from columns starting at row 0 with the output bitmap as input.
+    std::vector<double> round_latitude(length), round_longitude(length), round_altitude(length);
+    std::vector<std::uint8_t> round_validity((length + 7) / 8);
+    to_wgs84(length, DoubleColumn{E.data(), E_validity.data(), 0}, DoubleColumn{N.data(), nullptr, 0},
+             DoubleColumn{utm_altitude.data(), nullptr, 0}, zone_number.data(), zone_letter.data(),
+             MutableDoubleColumn{round_latitude.data(), round_validity.data()},
+             MutableDoubleColumn{round_longitude.data(), nullptr}, MutableDoubleColumn{round_altitude.data(), nullptr});
+    values = true;
+    validity = true;
+    for (std::size_t i = 0; i < length; ++i) {
+        WGS84 expected{UTM{WGS84{Degree{latitude[latitude_offset + i]}, Degree{longitude[longitude_offset + i]},
+                                 altitude[altitude_offset + i]}}};
+        values = values && same(round_latitude[i], expected.latitude) &&
+                 same(round_longitude[i], expected.longitude) && same(round_altitude[i], expected.altitude);
+        validity = validity && bit(round_validity, i) == expected_valid[i];
+    }
+    check(values, "UTM columns round trip as the constructors do");
+    check(validity, "validity survives the round trip");
+
+    // Gauss-Kruger from a sliced latitude column matches the constructors.
+    std::vector<double> x(length), y(length), height(length);
+    std::vector<std::uint8_t> x_validity((length + 7) / 8);
+    to_gauss_kruger(length, latitude_column, DoubleColumn{longitude.data(), nullptr, longitude_offset},
+                    altitude_column, MutableDoubleColumn{x.data(), x_validity.data()},
+                    MutableDoubleColumn{y.data(), nullptr}, MutableDoubleColumn{height.data(), nullptr});
+    values = true;
+    validity = true;
+    for (std::size_t i = 0; i < length; ++i) {
+        GaussKruger expected{SK42{WGS84{Degree{latitude[latitude_offset + i]},
+                                        Degree{longitude[longitude_offset + i]}, altitude[altitude_offset + i]}}};
+        values = values && same(x[i], expected.x) && same(y[i], expected.y) && same(height[i], expected.height);
+        validity = validity && bit(x_validity, i) == (i % 3 != 1);
+    }
+    check(values, "Gauss-Kruger columns read the rows at their offsets");
+    check(validity, "a missing bitmap reads as all valid");
+
+    return report();
+}
@@ -0,0 +1,78 @@
+#include "check.h"
+#include "conversion_cache.h"
+#include "transformations.h"
+
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+
+int main() {
+    std::atomic<int> conversions{0};
+    auto convert = [&conversions](const WGS84 &point) {
+        ++conversions;
+        return GaussKruger{SK42{point}};
+    };
+
+    // One shard of four entries, so eviction order is plain LRU.
+    ConversionCache<WGS84, GaussKruger> cache(convert, 4, 1);
+    std::vector<WGS84> points;
+    for (int i = 0; i < 5; ++i) {
+        points.push_back(WGS84{Degree{55.0 + i}, Degree{37.0 + i}, 100.0 * i});
+    }
+    GaussKruger first = cache(points[0]);
+    GaussKruger expected{SK42{points[0]}};
+    check(first.x == expected.x && first.y == expected.y && first.height == expected.height,
+          "a miss returns the conversion");
+    GaussKruger again = cache(WGS84{Degree{55.0 + 1e-11}, Degree{37.0}, 0.0002});
+    check(again.x == first.x && conversions == 1, "a point within the quanta hits");
+    check(cache.metrics().hits == 1 && cache.metrics().misses == 1, "hit and miss counted");
+
+    for (int i = 1; i < 5; ++i) {
+        cache(points[i]);
+    }
+    check(cache.metrics().evictions == 1 && conversions == 5, "the fifth entry evicts one");
+    cache(points[4]);
+    check(conversions == 5, "the newest entry is kept");
+    cache(points[0]);
+    check(conversions == 6, "the least recently used entry was the one evicted");
+    ConversionCache<WGS84, GaussKruger>::Metrics metrics = cache.metrics();
+    check(metrics.hits == 2 && metrics.misses == 6 && metrics.evictions == 2, "counters after eviction");
+    check(metrics.hit_rate() == 0.25, "hit rate");
+
+    // Values llround() cannot take bypass the cache.
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    double infinity = std::numeric_limits<double>::infinity();
+    std::vector<WGS84> unkeyable{WGS84{Degree{nan}, Degree{37.0}, 0}, WGS84{Degree{55.0}, Degree{infinity}, 0},
+                                 WGS84{Degree{55.0}, Degree{1e12}, 0}, WGS84{Degree{55.0}, Degree{37.0}, 1e300}};
+    conversions = 0;
+    std::vector<GaussKruger> converted = cache(unkeyable);
+    cache(unkeyable);
+    check(conversions == 8 && cache.metrics().misses == 14 && cache.metrics().evictions == 2,
+          "non-finite and out-of-range points are converted every time and never stored");
+    check(std::isnan(converted[0].x), "NaN still converts to NaN");
+
+    cache.clear();
+    check(cache.metrics().hits == 0 && cache.metrics().misses == 0 && cache.metrics().hit_rate() == 0,
+          "clear resets the counters");
+
+    // Every lookup is counted once under contention.
+    ConversionCache<WGS84, GaussKruger> shared(convert, 64);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&shared, &points] {
+            for (int i = 0; i < 1000; ++i) {
+                shared(points[i % points.size()]);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    metrics = shared.metrics();
+    check(metrics.hits + metrics.misses == 4000 && metrics.misses >= 5 && metrics.misses <= 20 &&
+          metrics.evictions == 0, "concurrent lookups");
+
+    return report();
+}
@@ -0,0 +1,97 @@
+#include "batch.h"
+#include "check.h"
+#include "fixed_math.h"
+#include "thread_pool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+std::uint64_t bits(double value) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, &value, sizeof word);
+    return word;
+}
+
+bool same_bits(const GaussKruger &a, const GaussKruger &b) {
+    return bits(a.x) == bits(b.x) && bits(a.y) == bits(b.y) && bits(a.height) == bits(b.height);
+}
+
+bool same_bits(const UTM &a, const UTM &b) {
+    return bits(a.E) == bits(b.E) && bits(a.N) == bits(b.N) && bits(a.altitude) == bits(b.altitude) &&
+           a.zone == b.zone;
+}
+
+bool same_bits(const WGS84 &a, const WGS84 &b) {
+    return bits(a.latitude) == bits(b.latitude) && bits(a.longitude) == bits(b.longitude) &&
+           bits(a.altitude) == bits(b.altitude);
+}
+
+}  // namespace
+
+int main() {
+    // fixed_math uses no libm, so its bits are the same on every platform.
+    check(bits(fixed_math::sin(0.5)) == 0x3fdeaee8744b05f0 && bits(fixed_math::cos(1)) == 0x3fe14a280fb5068c &&
+              bits(fixed_math::tan(0.7)) == 0x3feaf406c2fc78ad,
+          "fixed_math sin, cos and tan bits");
+    check(bits(fixed_math::atan2(1, 2)) == 0x3fddac670561bb4f &&
+              bits(fixed_math::pow(1.0001, 2.5)) == 0x3ff0010629e5b216 &&
+              bits(fixed_math::log(3)) == 0x3ff193ea7aad030a && bits(fixed_math::cbrt(10)) == 0x40013c484138704f,
+          "fixed_math atan2, pow, log and cbrt bits");
+
+#ifdef TRANSFORMATIONS_DETERMINISTIC
+    // Only a deterministic build promises these bits; libm may round the
+    // fast build's differently.
+    GaussKruger moscow{SK42{WGS84{Degree{55.75}, Degree{37.62}, 150}}};
+    UTM sydney{WGS84{Degree{-33.86}, Degree{151.21}, -12.5}};
+    check(bits(moscow.x) == 0x415794ce403fab0c && bits(moscow.y) == 0x415c47b7bcee98fa, "Gauss-Kruger bits");
+    check(bits(sydney.E) == 0x4114693675a3b33c && bits(sydney.N) == 0x4157c24d96bc8d28, "UTM bits");
+#endif
+
+    std::vector<WGS84> points;
+    for (int i = 0; i < 20000; ++i) {
+        points.push_back(WGS84{Degree{-79.9 + 0.0082 * i}, Degree{-179.9 + 0.01799 * i}, 0.5 * i});
+    }
+
+    // One thread, then the shared pool over small ranges.
+    std::vector<GaussKruger> gk;
+    std::vector<UTM> utm;
+    std::vector<WGS84> back;
+    for (const WGS84 &point : points) {
+        gk.push_back(GaussKruger{SK42{point}});
+        utm.push_back(UTM{point});
+        back.push_back(WGS84{SK42{gk.back()}});
+    }
+    std::vector<GaussKruger> pooled_gk(points.size(), gk.front());
+    std::vector<UTM> pooled_utm(points.size(), utm.front());
+    std::vector<WGS84> pooled_back(points.size(), back.front());
+    ThreadPool::shared().parallel_for(points.size(), 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            pooled_gk[i] = GaussKruger{SK42{points[i]}};
+            pooled_utm[i] = UTM{points[i]};
+            pooled_back[i] = WGS84{SK42{pooled_gk[i]}};
+        }
+    });
+
+    bool identical = true;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        identical = identical && same_bits(gk[i], pooled_gk[i]) && same_bits(utm[i], pooled_utm[i]) &&
+                    same_bits(back[i], pooled_back[i]);
+    }
+    check(identical, "pool threads give the bits of a single thread");
+
+    // The batch routes, in either order, give the same bits again.
+    std::vector<GaussKruger> batch_gk = to_gauss_kruger(points, ORDER::SPACE_FILLING_CURVE);
+    std::vector<UTM> batch_utm = to_utm(points);
+    std::vector<WGS84> batch_back = to_wgs84(batch_gk);
+    identical = batch_gk.size() == points.size() && batch_utm.size() == points.size();
+    for (std::size_t i = 0; identical && i < points.size(); ++i) {
+        identical = same_bits(gk[i], batch_gk[i]) && same_bits(utm[i], batch_utm[i]) &&
+                    same_bits(back[i], batch_back[i]);
+    }
+    check(identical, "batch routes give the bits of the constructors");
+
+    return report();
+}
@@ -0,0 +1,70 @@
+#include "check.h"
+#include "geodesic.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+bool near(double value, double expected, double tolerance) {
+    return std::fabs(value - expected) <= tolerance;
+}
+
+}  // namespace
+
+// Reference values are from GeographicLib 2.x on WGS84.
+int main() {
+    Geodesic geodesic(ELLIPSOID::WGS84);
+
+    // JFK -> LHR, the GeographicLib documentation example.
+    Geodesic::Inverse jfk_lhr = geodesic.inverse(Degree{40.6}, Degree{-73.8}, Degree{51.6}, Degree{-0.5});
+    check(near(jfk_lhr.distance, 5551759.400, 1e-3), "JFK -> LHR distance");
+    check(near(jfk_lhr.azimuth1, 51.19888285, 1e-8), "JFK -> LHR initial azimuth");
+    check(near(jfk_lhr.azimuth2, 107.82177674, 1e-8), "JFK -> LHR final azimuth");
+
+    // Wellington -> Salamanca is nearly antipodal.
+    Geodesic::Inverse antipodal = geodesic.inverse(Degree{-41.32}, Degree{174.81}, Degree{40.96}, Degree{-5.50});
+    check(near(antipodal.distance, 19959679.267, 1e-3), "Wellington -> Salamanca distance");
+    check(near(antipodal.azimuth1, 161.06766999, 1e-8), "Wellington -> Salamanca initial azimuth");
+    check(near(antipodal.azimuth2, 18.82519512, 1e-8), "Wellington -> Salamanca final azimuth");
+
+    Geodesic::Direct lhr = geodesic.direct(Degree{40.6}, Degree{-73.8}, Degree{51.198882845}, 5551759.400);
+    check(near(lhr.latitude, 51.6, 1e-8) && near(lhr.longitude, -0.5, 1e-8) && near(lhr.azimuth, 107.82177674, 1e-8),
+          "direct JFK -> LHR");
+    Geodesic::Direct far = geodesic.direct(Degree{10}, Degree{20}, Degree{30}, 1.5e7);
+    check(near(far.latitude, 28.83110592, 1e-8) && near(far.longitude, 175.98633506, 1e-8) &&
+          near(far.azimuth, 145.82689884, 1e-8), "direct over 15000 km");
+
+    // Direct then inverse returns the distance and azimuth it started from.
+    bool round_trip = true;
+    for (int i = 0; i < 200; ++i) {
+        double latitude = -80 + 0.8 * i;
+        double azimuth = -180 + 1.7 * i;
+        double distance = 1000 + 99000.0 * i;
+        Geodesic::Direct end = geodesic.direct(Degree{latitude}, Degree{10}, Degree{azimuth}, distance);
+        Geodesic::Inverse back = geodesic.inverse(Degree{latitude}, Degree{10}, end.latitude, end.longitude);
+        round_trip = round_trip && near(back.distance, distance, 1e-3) &&
+                     near(std::remainder(back.azimuth1 - azimuth, 360), 0, 1e-7);
+    }
+    check(round_trip, "direct/inverse round trips");
+
+    // The matrix form agrees with single inverse problems.
+    double latitude[] = {40.6, 51.6, -41.32};
+    double longitude[] = {-73.8, -0.5, 174.81};
+    std::vector<double> matrix = geodesic.distances(latitude, longitude, 3, latitude + 1, longitude + 1, 2);
+    check(matrix.size() == 6 && near(matrix[0], jfk_lhr.distance, 1e-6) && matrix[2] == 0 &&
+          near(matrix[5], 0, 1e-6), "distance matrix");
+
+    // A 1 degree square at the equator, and a square around the pole.
+    double square_latitude[] = {0, 0, 1, 1};
+    double square_longitude[] = {0, 1, 1, 0};
+    check(near(geodesic.area(square_latitude, square_longitude, 4), 12308778361.469, 1), "1 degree square");
+    double reversed_latitude[] = {1, 1, 0, 0};
+    check(near(geodesic.area(reversed_latitude, square_longitude, 4), 12308778361.469, 1),
+          "area ignores orientation");
+    double polar_latitude[] = {89, 89, 89, 89};
+    double polar_longitude[] = {0, 90, 180, 270};
+    check(near(geodesic.area(polar_latitude, polar_longitude, 4), 24952305678.0, 1), "square around the pole");
+
+    return report();
+}
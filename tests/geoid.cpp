@@ -0,0 +1,115 @@
+#include "check.h"
+#include "geoid.h"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+const char path[] = "geoid_test.grid";
+
+// A grid of 2 * row + 3 * column, which interpolation should reproduce.
+std::vector<float> plane(std::uint32_t rows, std::uint32_t columns) {
+    std::vector<float> values;
+    for (std::uint32_t r = 0; r < rows; ++r) {
+        for (std::uint32_t c = 0; c < columns; ++c) {
+            values.push_back(static_cast<float>(2 * r + 3 * c));
+        }
+    }
+    return values;
+}
+
+bool near(double value, double expected) {
+    return std::fabs(value - expected) < 1e-9;
+}
+
+}  // namespace
+
+int main() {
+    // Rows at 50, 50.5, ..., 52 and columns at 30, 30.25, ..., 31.25 degrees.
+    GeoidGrid::Header header{50, 30, 0.5, 0.25, 5, 6};
+    check(GeoidGrid::write(path, header, plane(5, 6)), "write a regional grid");
+    {
+        GeoidGrid grid(path);
+        check(grid.valid() && grid.header().rows == 5 && grid.header().columns == 6, "read the header");
+        auto at = [](double latitude, double longitude) {
+            return 2 * (latitude - 50) / 0.5 + 3 * (longitude - 30) / 0.25;
+        };
+
+        bool inside = true;
+        for (double latitude = 50; latitude <= 52; latitude += 0.125) {
+            for (double longitude = 30; longitude <= 31.25; longitude += 0.0625) {
+                inside = inside && near(grid.undulation(Degree{latitude}, Degree{longitude}), at(latitude, longitude));
+            }
+        }
+        check(inside, "bilinear reproduces a plane up to the last row and column");
+        check(near(grid.undulation(Degree{50.75}, Degree{30.6}, INTERPOLATION::BICUBIC), at(50.75, 30.6)),
+              "bicubic reproduces a plane away from the edges");
+
+        bool nodes = true;
+        for (double latitude : {50.0, 52.0}) {
+            for (double longitude : {30.0, 30.25, 31.25}) {
+                nodes = nodes && near(grid.undulation(Degree{latitude}, Degree{longitude}, INTERPOLATION::BICUBIC),
+                                      at(latitude, longitude));
+            }
+        }
+        check(nodes, "bicubic passes through the nodes on the edges and corners");
+        double edge = grid.undulation(Degree{50.1}, Degree{31.2}, INTERPOLATION::BICUBIC);
+        check(std::isfinite(edge) && std::fabs(edge - at(50.1, 31.2)) < 0.5,
+              "bicubic clamps its border in the edge cells");
+
+        bool outside = true;
+        for (double latitude : {49.999, 52.001}) {
+            outside = outside && std::isnan(grid.undulation(Degree{latitude}, Degree{30.5})) &&
+                      std::isnan(grid.undulation(Degree{latitude}, Degree{30.5}, INTERPOLATION::BICUBIC));
+        }
+        for (double longitude : {29.999, 31.251, 390.5}) {
+            outside = outside && std::isnan(grid.undulation(Degree{51}, Degree{longitude}));
+        }
+        outside = outside && std::isnan(grid.undulation(Degree{NAN}, Degree{30.5})) &&
+                  std::isnan(grid.undulation(Degree{51}, Degree{1e300}));
+        check(outside, "points off a regional grid are NaN");
+
+        double latitude[] = {50.2, 51.9, 60};
+        double longitude[] = {30.1, 31.0, 30.5};
+        double out[3];
+        grid.undulations(latitude, longitude, out, 3, INTERPOLATION::BICUBIC);
+        check(out[0] == grid.undulation(Degree{50.2}, Degree{30.1}, INTERPOLATION::BICUBIC) &&
+              out[1] == grid.undulation(Degree{51.9}, Degree{31.0}, INTERPOLATION::BICUBIC) && std::isnan(out[2]),
+              "the array form matches single lookups");
+    }
+
+    // A global grid of 8 columns 45 degrees apart wraps around.
+    header = GeoidGrid::Header{-90, -180, 45, 45, 5, 8};
+    check(GeoidGrid::write(path, header, plane(5, 8)), "write a global grid");
+    {
+        GeoidGrid grid(path);
+        check(grid.valid(), "read the global grid");
+        // Between the last column (135 E, value 21 + 2r) and the first (180 W, value 2r).
+        double across = grid.undulation(Degree{0}, Degree{157.5});
+        check(near(across, 4 + 0.5 * 21), "bilinear interpolates across the antimeridian");
+        check(grid.undulation(Degree{0}, Degree{-202.5}) == across &&
+              grid.undulation(Degree{0}, Degree{517.5}) == across, "longitudes outside -180..180 wrap");
+        double cubic = grid.undulation(Degree{10}, Degree{170}, INTERPOLATION::BICUBIC);
+        check(std::isfinite(cubic) && cubic == grid.undulation(Degree{10}, Degree{-190}, INTERPOLATION::BICUBIC),
+              "bicubic wraps its border columns");
+        check(near(grid.undulation(Degree{90}, Degree{-180}, INTERPOLATION::BICUBIC), 8),
+              "the last row of a global grid is a sample");
+    }
+
+    // Files that are not grids are rejected.
+    std::FILE *file = std::fopen(path, "wb");
+    std::fputs("GEOID02 and then some bytes that are long enough for a header", file);
+    std::fclose(file);
+    {
+        GeoidGrid grid(path);
+        check(!grid.valid() && std::isnan(grid.undulation(Degree{51}, Degree{30.5})), "wrong magic");
+    }
+    header = GeoidGrid::Header{50, 30, 0.5, 0.25, 5, 6};
+    check(!GeoidGrid::write(path, header, plane(5, 5)), "write refuses a value count that does not match");
+    check(!GeoidGrid("no_such_geoid.grid").valid(), "missing file");
+
+    std::remove(path);
+    return report();
+}
@@ -0,0 +1,64 @@
+#include "check.h"
+#include "geometry.h"
+
+#include <cmath>
+
+namespace {
+
+Geometry<WGS84> line(double latitude, double longitude1, double longitude2) {
+    Geometry<WGS84> geometry;
+    geometry.vertices = {WGS84{Degree{latitude}, Degree{longitude1}, 0},
+                         WGS84{Degree{latitude}, Degree{longitude2}, 0}};
+    geometry.offsets = {0, 2};
+    return geometry;
+}
+
+bool same(const Geometry<UTM> &a, const Geometry<UTM> &b) {
+    if (a.offsets != b.offsets || a.vertices.size() != b.vertices.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.vertices.size(); ++i) {
+        if (a.vertices[i].E != b.vertices[i].E || a.vertices[i].N != b.vertices[i].N) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main() {
+    // A one-degree segment across the antimeridian is densified like one
+    // beside it, not split down to the recursion limit.
+    std::size_t across = to_utm(line(60, 179.5, -179.5), 0.01).vertices.size();
+    std::size_t beside = to_utm(line(60, 178.5, 179.5), 0.01).vertices.size();
+    check(across < 2 * beside, "antimeridian segment densified like its neighbour");
+
+    // Large geometries go to the thread pool; the parts must come out exactly
+    // as when each is projected on its own.
+    Geometry<WGS84> many;
+    many.offsets.push_back(0);
+    for (int part = 0; part < 400; ++part) {
+        for (int v = 0; v < 8; ++v) {
+            double angle = v * 0.785398163397448;
+            many.vertices.push_back(WGS84{Degree{50 + part % 20 * 0.1 + 0.05 * std::sin(angle)},
+                                          Degree{37 + part / 20 * 0.1 + 0.05 * std::cos(angle)}, 0});
+        }
+        many.offsets.push_back(many.vertices.size());
+    }
+    Geometry<UTM> pooled = to_utm(many, 0.01);
+    Geometry<UTM> serial;
+    serial.offsets.push_back(0);
+    for (std::size_t part = 0; part + 1 < many.offsets.size(); ++part) {
+        Geometry<WGS84> single;
+        single.vertices.assign(many.vertices.begin() + many.offsets[part],
+                               many.vertices.begin() + many.offsets[part + 1]);
+        single.offsets = {0, single.vertices.size()};
+        Geometry<UTM> projected = to_utm(single, 0.01);
+        serial.vertices.insert(serial.vertices.end(), projected.vertices.begin(), projected.vertices.end());
+        serial.offsets.push_back(serial.vertices.size());
+    }
+    check(same(pooled, serial), "pooled parts match serial parts");
+
+    return report();
+}
@@ -0,0 +1,78 @@
+#include "check.h"
+#include "geometry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Extent of a brute-force grid of the box, projected the way the envelope
+// functions must: into the zone (and hemisphere) of the box centre.
+template <class Project>
+Envelope grid_extent(const Envelope &box, int steps, Project project_one) {
+    double infinity = std::numeric_limits<double>::infinity();
+    Envelope result{infinity, infinity, -infinity, -infinity};
+    for (int i = 0; i <= steps; ++i) {
+        for (int j = 0; j <= steps; ++j) {
+            double longitude = box.min_x + (box.max_x - box.min_x) * i / steps;
+            double latitude = box.min_y + (box.max_y - box.min_y) * j / steps;
+            double x, y;
+            project_one(WGS84{Degree{latitude}, Degree{longitude}, 0}, x, y);
+            result.min_x = std::min(result.min_x, x);
+            result.min_y = std::min(result.min_y, y);
+            result.max_x = std::max(result.max_x, x);
+            result.max_y = std::max(result.max_y, y);
+        }
+    }
+    return result;
+}
+
+bool contains(const Envelope &outer, const Envelope &inner) {
+    return outer.min_x <= inner.min_x && outer.min_y <= inner.min_y &&
+           outer.max_x >= inner.max_x && outer.max_y >= inner.max_y;
+}
+
+// The envelope may exceed the true extent by the tolerance plus the sag of
+// the chords it bounds, never by a whole zone.
+bool tight(const Envelope &outer, const Envelope &inner, double slack) {
+    return outer.min_x >= inner.min_x - slack && outer.min_y >= inner.min_y - slack &&
+           outer.max_x <= inner.max_x + slack && outer.max_y <= inner.max_y + slack;
+}
+
+void gauss_kruger(const Envelope &box, int zone, const char *what) {
+    Envelope projected = envelope_to_gauss_kruger(box, 0.5);
+    Envelope extent = grid_extent(box, 400, [zone](const WGS84 &point, double &x, double &y) {
+        GaussKruger gk = GaussKruger::in_zones(SK42{point}, {zone})[0];
+        x = gk.x;
+        y = gk.y;
+    });
+    check(contains(projected, extent), what);
+    check(tight(projected, extent, 5), what);
+}
+
+void utm(const Envelope &box, int zone, bool south, const char *what) {
+    Envelope projected = envelope_to_utm(box, 0.5);
+    Envelope extent = grid_extent(box, 400, [zone, south](const WGS84 &point, double &x, double &y) {
+        UTM utm = UTM::in_zones(point, {zone})[0];
+        x = utm.E;
+        y = utm.N + (south && point.latitude >= 0 ? UTM::N0 : 0) - (!south && point.latitude < 0 ? UTM::N0 : 0);
+    });
+    check(contains(projected, extent), what);
+    check(tight(projected, extent, 5), what);
+}
+
+}  // namespace
+
+int main() {
+    // 1x1 degree box around Moscow, inside GK zone 7 and UTM zone 37.
+    gauss_kruger(Envelope{37.1, 55.3, 38.1, 56.3}, 7, "Moscow box in Gauss-Kruger");
+    utm(Envelope{37.1, 55.3, 38.1, 56.3}, 37, false, "Moscow box in UTM");
+    // Straddles the 36E boundary between GK zones 6 and 7 (centre in 7).
+    gauss_kruger(Envelope{35.5, 55.0, 36.7, 56.0}, 7, "box across a Gauss-Kruger zone boundary");
+    // Straddles the equator (centre north) and a UTM zone boundary.
+    utm(Envelope{29.5, -0.5, 30.7, 1.0}, 36, false, "box across the equator");
+    utm(Envelope{29.5, -1.0, 30.7, 0.5}, 36, true, "box across the equator, centre south");
+
+    return report();
+}
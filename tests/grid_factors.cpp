@@ -0,0 +1,97 @@
+#include "batch.h"
+#include "check.h"
+#include "transformations.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// Convergence in degrees and scale factor from Karney's Krueger series to n^4,
+// at `offset` degrees from the central meridian. The projections use the
+// shorter Redfearn series, good to about 2e-8 degrees 3 degrees out.
+struct Reference {
+    double latitude;
+    double offset;
+    double convergence;
+    double scale;
+};
+
+bool near(const GridFactors &factors, const Reference &reference) {
+    return std::fabs(factors.convergence - reference.convergence) < 5e-8 &&
+           std::fabs(factors.scale - reference.scale) < 1e-8;
+}
+
+}  // namespace
+
+int main() {
+    // UTM zones 36 and 37 have their central meridians at 33 and 39 degrees.
+    const Reference utm[] = {
+        {30, -1.38, -0.6901016071, 0.9998185838},
+        {55.75, -1.38, -1.1407641691, 0.9996920293},
+        {30, 2.9, 1.4509434071, 1.0005657244},
+        {55.75, 2.9, 2.3977627956, 1.0000063306},
+        {-40, -1.38, 0.8871487653, 0.9997708275},
+        {-40, 2.9, -1.8650296698, 1.0003545467},
+        {80, -3.1, -3.0529938689, 0.9996440867},
+    };
+    bool matches = true;
+    bool unchanged = true;
+    std::vector<WGS84> points;
+    for (const Reference &reference : utm) {
+        double meridian = reference.offset < 0 ? 39 : 33;
+        WGS84 point{Degree{reference.latitude}, Degree{meridian + reference.offset}, 10};
+        points.push_back(point);
+        GridFactors factors{};
+        UTM with(point, factors);
+        UTM without(point);
+        matches = matches && near(factors, reference);
+        unchanged = unchanged && with.E == without.E && with.N == without.N && with.zone == without.zone;
+    }
+    check(matches, "UTM convergence and scale match the reference");
+    check(unchanged, "reporting factors leaves the UTM projection unchanged");
+
+    std::vector<GridFactors> factors;
+    std::vector<UTM> batch = to_utm(points, factors);
+    matches = batch.size() == points.size() && factors.size() == points.size();
+    for (std::size_t i = 0; matches && i < points.size(); ++i) {
+        GridFactors single{};
+        UTM utm(points[i], single);
+        matches = factors[i].convergence == single.convergence && factors[i].scale == single.scale &&
+                  batch[i].E == utm.E;
+    }
+    check(matches, "the batch overload reports the per-point factors");
+
+    GridFactors central{};
+    UTM on_meridian(WGS84{Degree{55.75}, Degree{39}, 0}, central);
+    check(central.convergence == 0 && central.scale == UTM::k0 && on_meridian.E == UTM::E0,
+          "no convergence and k0 on the central meridian");
+
+    // Gauss-Kruger on the Krassovsky ellipsoid with a unit central scale;
+    // zones 6 and 7 have their central meridians at 33 and 39 degrees.
+    const Reference gauss_kruger[] = {
+        {55.75, -1.38, -1.1407641690, 1.0000920661},
+        {30, 2.9, 1.4509434051, 1.0009661101},
+        {-40, 2.9, -1.8650296681, 1.0007548482},
+        {80, -2.9, -2.8560160335, 1.0000386014},
+    };
+    matches = true;
+    unchanged = true;
+    for (const Reference &reference : gauss_kruger) {
+        double meridian = reference.offset < 0 ? 39 : 33;
+        SK42 point{Degree{reference.latitude}, Degree{meridian + reference.offset}, 10};
+        GridFactors factors{};
+        GaussKruger with(point, factors);
+        GaussKruger without(point);
+        matches = matches && near(factors, reference);
+        unchanged = unchanged && with.x == without.x && with.y == without.y;
+    }
+    check(matches, "Gauss-Kruger convergence and scale match the reference");
+    check(unchanged, "reporting factors leaves the Gauss-Kruger projection unchanged");
+
+    GaussKruger gk_on_meridian(SK42{Degree{55.75}, Degree{39}, 0}, central);
+    check(central.convergence == 0 && central.scale == 1 && gk_on_meridian.y == 7500000,
+          "no convergence and unit scale on the central meridian");
+
+    return report();
+}
@@ -0,0 +1,93 @@
+#include "check.h"
+#include "helmert.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+bool near(double value, double expected, double tolerance) {
+    return std::fabs(value - expected) <= tolerance;
+}
+
+bool near(const ECEF &a, const ECEF &b, double tolerance) {
+    return near(a.x, b.x, tolerance) && near(a.y, b.y, tolerance) && near(a.z, b.z, tolerance);
+}
+
+}  // namespace
+
+int main() {
+    const double radians_per_mas = radians_per_degree / 3600e3;
+
+    // Parameters at 2010.0 with rates, so 2014.0 adds four years of drift.
+    HelmertParams parameters{-0.013, 0.106, 0.022, -2.3, -2.3, 3.54, -4.21};
+    HelmertParams rates{0.001, -0.002, 0.003, 0.1, 0.05, -0.02, 0.01};
+    Helmert helmert(parameters, rates, 2010.0);
+    Helmert::Matrix matrix = helmert.at(2014.0);
+    double m = 1 + (-2.3 + 0.4) * 1e-9;
+    double rx = (-2.3 + 0.2) * radians_per_mas;
+    double ry = (3.54 - 0.08) * radians_per_mas;
+    double rz = (-4.21 + 0.04) * radians_per_mas;
+    check(near(matrix.t[0], -0.009, 1e-15) && near(matrix.t[1], 0.098, 1e-15) && near(matrix.t[2], 0.034, 1e-15),
+          "translations with rates");
+    check(near(matrix.r[0][0], m, 1e-15) && near(matrix.r[0][1], -m * rz, 1e-20) &&
+          near(matrix.r[0][2], m * ry, 1e-20) && near(matrix.r[1][0], m * rz, 1e-20) &&
+          near(matrix.r[1][2], -m * rx, 1e-20) && near(matrix.r[2][0], -m * ry, 1e-20) &&
+          near(matrix.r[2][1], m * rx, 1e-20), "scale and rotations in the position-vector convention");
+
+    // A rotation about z turns the x axis towards +y.
+    Helmert turn(HelmertParams{0, 0, 0, 0, 0, 0, 1000}, HelmertParams{}, 2000);
+    ECEF turned = turn.transform(ECEF{6378137, 0, 0}, 2000);
+    check(near(turned.y, 6378137.0 * 1000 * radians_per_mas, 1e-9) && near(turned.z, 0, 1e-12),
+          "positive rz rotates x towards y");
+
+    // The inverse matrix undoes the forward one and inverts back to it.
+    ECEF point{2849220.5, 2186385.1, 5252820.3};
+    Helmert::Matrix inverse = matrix.inverse();
+    check(near(inverse.apply(matrix.apply(point)), point, 1e-9) &&
+          near(matrix.apply(inverse.apply(point)), point, 1e-9), "inverse().apply() undoes apply()");
+    Helmert::Matrix twice = inverse.inverse();
+    bool same = true;
+    for (int i = 0; i < 3; ++i) {
+        same = same && near(twice.t[i], matrix.t[i], 1e-12);
+        for (int j = 0; j < 3; ++j) {
+            same = same && near(twice.r[i][j], matrix.r[i][j], 1e-15);
+        }
+    }
+    check(same, "the inverse of the inverse is the matrix");
+
+    // Geodetic routes round trip, and the batch forms match single points.
+    std::vector<PZ90> pz_90;
+    std::vector<double> epochs;
+    for (int i = 0; i < 20; ++i) {
+        pz_90.push_back(PZ90{Degree{-60 + 6.0 * i}, Degree{-170 + 17.0 * i}, 100.0 * i});
+        epochs.push_back(2010 + (i / 5));
+    }
+    std::vector<WGS84> wgs_84 = helmert.to_wgs84(pz_90, epochs);
+    std::vector<PZ90> back = helmert.to_pz90(wgs_84, epochs);
+    bool round_trip = true;
+    bool batch = true;
+    for (std::size_t i = 0; i < pz_90.size(); ++i) {
+        round_trip = round_trip && near(back[i].latitude, pz_90[i].latitude, 1e-10) &&
+                     near(back[i].longitude, pz_90[i].longitude, 1e-10) &&
+                     near(back[i].altitude, pz_90[i].altitude, 1e-6);
+        WGS84 single = helmert.to_wgs84(pz_90[i], epochs[i]);
+        batch = batch && single.latitude == wgs_84[i].latitude && single.longitude == wgs_84[i].longitude &&
+                single.altitude == wgs_84[i].altitude;
+    }
+    check(round_trip, "PZ90 -> WGS84 -> PZ90 round trip");
+    check(batch, "per-point epochs match single conversions");
+    std::vector<WGS84> one_epoch = helmert.to_wgs84(pz_90, 2012.0);
+    check(one_epoch[7].latitude == helmert.to_wgs84(pz_90[7], 2012.0).latitude, "single-epoch batch");
+
+    bool thrown = false;
+    try {
+        helmert.to_wgs84(pz_90, std::vector<double>(3, 2010.0));
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    check(thrown, "an epoch count that does not match throws std::invalid_argument");
+
+    return report();
+}
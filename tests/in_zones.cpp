@@ -0,0 +1,71 @@
+#include "check.h"
+#include "transformations.h"
+
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+template <class Call>
+bool throws_invalid_argument(Call call) {
+    try {
+        call();
+    } catch (const std::invalid_argument &) {
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+int main() {
+    std::vector<int> zones{1, 6, 7, 36, 37, 60};
+    bool same = true;
+    for (int i = 0; i < 50; ++i) {
+        WGS84 point{Degree{-79 + 3.3 * i}, Degree{-179 + 7.1 * i}, 5.0 * i};
+        std::vector<UTM> utm = UTM::in_zones(point, zones);
+        std::vector<GaussKruger> gk = GaussKruger::in_zones(SK42{point}, zones);
+        for (std::size_t z = 0; z < zones.size(); ++z) {
+            UTM one_utm = UTM::in_zone(point, zones[z]);
+            GaussKruger one_gk = GaussKruger::in_zone(SK42{point}, zones[z]);
+            same = same && one_utm.E == utm[z].E && one_utm.N == utm[z].N && one_utm.zone == utm[z].zone &&
+                   one_utm.altitude == utm[z].altitude && one_gk.x == gk[z].x && one_gk.y == gk[z].y &&
+                   one_gk.height == gk[z].height;
+        }
+    }
+    check(same, "in_zone matches in_zones");
+
+    // Zones are chosen by the caller, so one outside 1-60 throws.
+    WGS84 point{Degree{55.75}, Degree{37.62}, 150};
+    SK42 sk_42{point};
+    bool thrown = true;
+    for (int zone : {0, -1, 61, 1000}) {
+        thrown = thrown && throws_invalid_argument([&] { UTM::in_zones(point, {37, zone}); }) &&
+                 throws_invalid_argument([&] { GaussKruger::in_zones(sk_42, {zone, 7}); }) &&
+                 throws_invalid_argument([&] { UTM::in_zone(point, zone); }) &&
+                 throws_invalid_argument([&] { GaussKruger::in_zone(sk_42, zone); });
+    }
+    check(thrown, "zones outside 1-60 throw std::invalid_argument");
+    check(!throws_invalid_argument([&] { UTM::in_zones(point, {1, 60}); }) &&
+          !throws_invalid_argument([&] { GaussKruger::in_zones(sk_42, {1, 60}); }) &&
+          UTM::in_zones(point, {}).empty(), "zones 1 and 60 and an empty list are accepted");
+
+    // Band letters are case-insensitive, in both hemispheres.
+    bool lowercase = true;
+    for (const WGS84 &point : {WGS84{Degree{55.75}, Degree{37.62}, 150}, WGS84{Degree{-33.86}, Degree{151.21}, 20}}) {
+        UTM upper{point};
+        UTM lower = upper;
+        lower.zone.back() = static_cast<char>(lower.zone.back() - 'A' + 'a');
+        WGS84 from_upper{upper};
+        WGS84 from_lower{lower};
+        int number = 0;
+        char letter = 0;
+        lowercase = lowercase && from_lower.latitude == from_upper.latitude &&
+                    from_lower.longitude == from_upper.longitude && validate(lower) == STATUS_OK &&
+                    UTM::parse_zone(lower.zone, number, letter) && letter == upper.zone.back();
+    }
+    check(lowercase, "lowercase band letters read as uppercase");
+    check(!UTM::valid_zone(37, 'i') && !UTM::valid_zone(37, 'o'), "lowercase non-band letters are invalid");
+
+    return report();
+}
@@ -0,0 +1,104 @@
+#include "batch.h"
+#include "check.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+const double degree = 3.14159265358979323846 / 180;
+
+// Central differences of the projection in `zone`, so that a step across a
+// zone border does not jump; in metres per radian.
+Jacobian differences(const SK42 &point, int zone) {
+    const double step = 1e-6;  // rad, about 6 m on the ground
+    double B = point.latitude;
+    double L = point.longitude;
+    double h = step / degree;
+    GaussKruger north = GaussKruger::in_zone(SK42{Degree{B + h}, Degree{L}, point.altitude}, zone);
+    GaussKruger south = GaussKruger::in_zone(SK42{Degree{B - h}, Degree{L}, point.altitude}, zone);
+    GaussKruger east = GaussKruger::in_zone(SK42{Degree{B}, Degree{L + h}, point.altitude}, zone);
+    GaussKruger west = GaussKruger::in_zone(SK42{Degree{B}, Degree{L - h}, point.altitude}, zone);
+    return Jacobian{(north.x - south.x) / (2 * step), (east.x - west.x) / (2 * step),
+                    (north.y - south.y) / (2 * step), (east.y - west.y) / (2 * step)};
+}
+
+double difference(const Jacobian &a, const Jacobian &b) {
+    return std::max(std::max(std::fabs(a.dx_dB - b.dx_dB), std::fabs(a.dx_dL - b.dx_dL)),
+                    std::max(std::fabs(a.dy_dB - b.dy_dB), std::fabs(a.dy_dL - b.dy_dL)));
+}
+
+}  // namespace
+
+int main() {
+    // Across a zone, on its central meridian and near its edges, from the
+    // equator to high latitudes in both hemispheres.
+    std::vector<WGS84> points;
+    for (int i = 0; i <= 16; ++i) {
+        for (int j = 0; j <= 6; ++j) {
+            points.push_back(WGS84{Degree{-80 + 10 * i + 0.37}, Degree{36.02 + 0.99 * j}, 100.0 * i});
+        }
+    }
+
+    double worst = 0;
+    bool values = true;
+    for (const WGS84 &point : points) {
+        SK42 sk_42{point};
+        Jacobian jacobian;
+        GaussKruger gk{sk_42, jacobian};
+        GaussKruger plain{sk_42};
+        values = values && gk.x == plain.x && gk.y == plain.y && gk.height == plain.height;
+        worst = std::max(worst, difference(jacobian, differences(sk_42, static_cast<int>(gk.y / 1e6))));
+    }
+    check(values, "the Jacobian constructor projects as the plain one");
+    // The derivatives are up to 6.4e6 m/rad; rounding in the differences is
+    // about 1e-3.
+    check(worst < 1e-2, "dual-number Jacobian matches central differences");
+
+    // The batch overloads give the constructor's Jacobian and J C J^T.
+    std::vector<Jacobian> jacobians;
+    std::vector<GaussKruger> gk = to_gauss_kruger(points, jacobians);
+    std::vector<Covariance> covariances;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        // About 1 m and 2 m on the ground, slightly correlated.
+        double s_B = 1.6e-7;
+        double s_L = 3.1e-7;
+        covariances.push_back(Covariance{s_B * s_B, 0.2 * s_B * s_L * (i % 3 == 0 ? -1 : 1), s_L * s_L});
+    }
+    std::vector<Covariance> projected;
+    std::vector<GaussKruger> projected_gk = to_gauss_kruger(points, covariances, projected);
+    bool batch = jacobians.size() == points.size() && projected.size() == points.size();
+    bool propagated = batch;
+    for (std::size_t i = 0; batch && i < points.size(); ++i) {
+        SK42 sk_42{points[i]};
+        Jacobian expected;
+        GaussKruger{sk_42, expected};
+        batch = batch && difference(jacobians[i], expected) == 0 && gk[i].x == projected_gk[i].x &&
+                gk[i].y == projected_gk[i].y;
+
+        Jacobian J = differences(sk_42, static_cast<int>(gk[i].y / 1e6));
+        const Covariance &C = covariances[i];
+        double c00 = J.dx_dB * J.dx_dB * C.c00 + 2 * J.dx_dB * J.dx_dL * C.c01 + J.dx_dL * J.dx_dL * C.c11;
+        double c01 = J.dx_dB * J.dy_dB * C.c00 + (J.dx_dB * J.dy_dL + J.dx_dL * J.dy_dB) * C.c01 +
+                     J.dx_dL * J.dy_dL * C.c11;
+        double c11 = J.dy_dB * J.dy_dB * C.c00 + 2 * J.dy_dB * J.dy_dL * C.c01 + J.dy_dL * J.dy_dL * C.c11;
+        double scale = c00 + c11;
+        propagated = propagated && std::fabs(projected[i].c00 - c00) < 1e-9 * scale &&
+                     std::fabs(projected[i].c01 - c01) < 1e-9 * scale &&
+                     std::fabs(projected[i].c11 - c11) < 1e-9 * scale;
+    }
+    check(batch, "batch Jacobians match the constructor");
+    check(propagated, "batch covariances are J C J^T of the differenced Jacobian");
+
+    bool threw = false;
+    try {
+        to_gauss_kruger(points, std::vector<Covariance>(1), projected);
+    } catch (const std::invalid_argument &) {
+        threw = true;
+    }
+    check(threw, "one covariance per point is required");
+
+    return report();
+}
@@ -0,0 +1,107 @@
+#include "check.h"
+#include "ecef.h"
+#include "ellipsoid.h"
+#include "local_frame.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+bool near(double value, double expected, double tolerance) {
+    return std::fabs(value - expected) <= tolerance;
+}
+
+}  // namespace
+
+int main() {
+    // Geodetic <-> ECEF on every ellipsoid, from pole to pole and from below
+    // the sea to orbit.
+    bool round_trip = true;
+    for (ELLIPSOID which : {ELLIPSOID::WGS84, ELLIPSOID::PZ90, ELLIPSOID::SK42}) {
+        for (double latitude = -90; latitude <= 90; latitude += 7.5) {
+            for (double height : {-1000.0, 0.0, 8848.0, 400e3, 20e6}) {
+                double longitude = -179 + 3.7 * (latitude + 90);
+                ECEF ecef = to_ecef(Degree{latitude}, Degree{longitude}, height, which);
+                Degree B, L;
+                double H = 0;
+                to_geodetic(ecef, which, B, L, H);
+                round_trip = round_trip && near(B, latitude, 1e-11) && near(H, height, 1e-6) &&
+                             (std::fabs(latitude) == 90 || near(std::remainder(L - longitude, 360), 0, 1e-11));
+            }
+        }
+    }
+    check(round_trip, "geodetic -> ECEF -> geodetic");
+
+    Ellipsoid wgs84 = ellipsoid(ELLIPSOID::WGS84);
+    ECEF equator{WGS84{Degree{0}, Degree{90}, 10}};
+    ECEF pole{WGS84{Degree{90}, Degree{0}, 0}};
+    check(near(equator.x, 0, 1e-9) && near(equator.y, wgs84.a + 10, 1e-9) && near(pole.z, wgs84.b(), 1e-9),
+          "ECEF of the equator and the pole");
+
+    // The tangent plane at Moscow.
+    WGS84 origin{Degree{55.75}, Degree{37.62}, 150};
+    LocalFrame frame(origin);
+    ECEF centre{origin};
+    ENU at_origin = frame.to_enu(centre);
+    check(near(at_origin.east, 0, 1e-9) && near(at_origin.north, 0, 1e-9) && near(at_origin.up, 0, 1e-9),
+          "the origin is at zero");
+    ENU above = frame.to_enu(WGS84{Degree{55.75}, Degree{37.62}, 1150});
+    check(near(above.east, 0, 1e-8) && near(above.north, 0, 1e-8) && near(above.up, 1000, 1e-8),
+          "up is along the ellipsoid normal");
+    ENU north = frame.to_enu(WGS84{Degree{55.76}, Degree{37.62}, 150});
+    ENU east = frame.to_enu(WGS84{Degree{55.75}, Degree{37.63}, 150});
+    // A parallel curves away from the plane, north of its tangent.
+    check(north.north > 1100 && near(north.east, 0, 1e-8) && east.east > 600 && near(east.north, 0.045, 0.001),
+          "north and east point along the meridian and the parallel");
+
+    // The rotation keeps lengths, and ENU <-> NED is a relabelling.
+    ECEF offset{centre.x + 300, centre.y - 400, centre.z + 1200};
+    ENU enu = frame.to_enu(offset);
+    NED ned = frame.to_ned(offset);
+    check(near(std::sqrt(enu.east * enu.east + enu.north * enu.north + enu.up * enu.up), 1300, 1e-9),
+          "distances are kept");
+    check(ned.north == enu.north && ned.east == enu.east && ned.down == -enu.up, "NED is ENU relabelled");
+
+    ECEF from_enu = frame.to_ecef(enu);
+    ECEF from_ned = frame.to_ecef(ned);
+    check(near(from_enu.x, offset.x, 1e-8) && near(from_enu.y, offset.y, 1e-8) && near(from_enu.z, offset.z, 1e-8),
+          "ECEF -> ENU -> ECEF");
+    check(near(from_ned.x, offset.x, 1e-8) && near(from_ned.y, offset.y, 1e-8) && near(from_ned.z, offset.z, 1e-8),
+          "ECEF -> NED -> ECEF");
+    WGS84 point{Degree{55.8}, Degree{37.5}, 210};
+    WGS84 back = frame.to_wgs84(frame.to_enu(point));
+    check(near(back.latitude, 55.8, 1e-11) && near(back.longitude, 37.5, 1e-11) && near(back.altitude, 210, 1e-6),
+          "WGS84 -> ENU -> WGS84");
+    back = frame.to_wgs84(frame.to_ned(point));
+    check(near(back.latitude, 55.8, 1e-11) && near(back.longitude, 37.5, 1e-11) && near(back.altitude, 210, 1e-6),
+          "WGS84 -> NED -> WGS84");
+
+    // The column kernels and batch forms match the point forms, in place too.
+    std::vector<ECEF> points;
+    for (int i = 0; i < 37; ++i) {
+        points.push_back(ECEF{centre.x + 100.0 * i, centre.y - 50.0 * i, centre.z + 25.0 * i});
+    }
+    std::vector<double> x, y, z;
+    for (const ECEF &p : points) {
+        x.push_back(p.x);
+        y.push_back(p.y);
+        z.push_back(p.z);
+    }
+    frame.to_enu(x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), points.size());
+    std::vector<ENU> batch = frame.to_enu(points);
+    bool columns = true;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        ENU single = frame.to_enu(points[i]);
+        columns = columns && near(x[i], single.east, 1e-9) && near(y[i], single.north, 1e-9) &&
+                  near(z[i], single.up, 1e-9) && batch[i].east == single.east && batch[i].up == single.up;
+    }
+    frame.to_ecef(x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), points.size());
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        columns = columns && near(x[i], points[i].x, 1e-8) && near(y[i], points[i].y, 1e-8) &&
+                  near(z[i], points[i].z, 1e-8);
+    }
+    check(columns, "column kernels round trip in place and match single points");
+
+    return report();
+}
@@ -0,0 +1,172 @@
+#include "check.h"
+#include "ntv2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char path[] = "ntv2_test.gsb";
+
+// Writes NTv2 records, in the host byte order or swapped.
+class Writer {
+ public:
+    explicit Writer(bool swapped) : _swapped(swapped) {}
+
+    template <class T>
+    void record(const char *name, T value) {
+        std::string key(name);
+        key.resize(8, ' ');
+        _bytes.insert(_bytes.end(), key.begin(), key.end());
+        append(value);
+        _bytes.resize(_bytes.size() + 8 - sizeof(T), 0);
+    }
+
+    void text(const char *name, const char *value) {
+        std::string key(name);
+        std::string text(value);
+        key.resize(8, ' ');
+        text.resize(8, ' ');
+        _bytes.insert(_bytes.end(), key.begin(), key.end());
+        _bytes.insert(_bytes.end(), text.begin(), text.end());
+    }
+
+    template <class T>
+    void append(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        if (_swapped) {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        _bytes.insert(_bytes.end(), bytes, bytes + sizeof(T));
+    }
+
+    bool save(std::size_t size) const {
+        std::FILE *file = std::fopen(path, "wb");
+        bool written = file && std::fwrite(_bytes.data(), 1, size, file) == size;
+        return file && std::fclose(file) == 0 && written;
+    }
+    std::size_t size() const { return _bytes.size(); }
+
+ private:
+    bool _swapped;
+    std::vector<char> _bytes;
+};
+
+// Bounds in arc seconds, longitude positive west, as in the file.
+struct Bounds {
+    double south, north, east, west, step;
+};
+
+template <class Shift>
+void sub_grid(Writer &writer, const char *name, const char *parent, const Bounds &bounds, Shift shift) {
+    int rows = static_cast<int>(std::lround((bounds.north - bounds.south) / bounds.step)) + 1;
+    int columns = static_cast<int>(std::lround((bounds.west - bounds.east) / bounds.step)) + 1;
+    writer.text("SUB_NAME", name);
+    writer.text("PARENT", parent);
+    writer.text("CREATED", "");
+    writer.text("UPDATED", "");
+    writer.record("S_LAT", bounds.south);
+    writer.record("N_LAT", bounds.north);
+    writer.record("E_LONG", bounds.east);
+    writer.record("W_LONG", bounds.west);
+    writer.record("LAT_INC", bounds.step);
+    writer.record("LONG_INC", bounds.step);
+    writer.record("GS_COUNT", static_cast<std::int32_t>(rows * columns));
+    // Rows from the south, nodes within a row from the east.
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c) {
+            float latitude_shift = 0;
+            float west_shift = 0;
+            shift(r, c, latitude_shift, west_shift);
+            writer.append(latitude_shift);
+            writer.append(west_shift);
+            writer.append(0.0f);
+            writer.append(0.0f);
+        }
+    }
+}
+
+// A 2x2 degree parent grid over 50-52N, 30-32E with shifts linear in the
+// node indices, and a child over 50.5-51N, 30.5-31E with a constant shift.
+Writer grid_file(bool swapped) {
+    Writer writer(swapped);
+    writer.record("NUM_OREC", std::int32_t{11});
+    writer.record("NUM_SREC", std::int32_t{11});
+    writer.record("NUM_FILE", std::int32_t{2});
+    writer.text("GS_TYPE", "SECONDS");
+    writer.text("VERSION", "NTv2.0");
+    writer.text("SYSTEM_F", "SK42");
+    writer.text("SYSTEM_T", "WGS84");
+    writer.record("MAJOR_F", 6378245.0);
+    writer.record("MINOR_F", 6356863.019);
+    writer.record("MAJOR_T", 6378137.0);
+    writer.record("MINOR_T", 6356752.314);
+    sub_grid(writer, "PARENT", "NONE", Bounds{180000, 187200, -115200, -108000, 1800},
+             [](int r, int c, float &latitude, float &west) {
+                 latitude = 1 + 0.5f * r;
+                 west = 2 + 0.25f * c;
+             });
+    sub_grid(writer, "CHILD", "PARENT", Bounds{181800, 183600, -111600, -109800, 900},
+             [](int, int, float &latitude, float &west) {
+                 latitude = 10;
+                 west = 20;
+             });
+    return writer;
+}
+
+bool near(double value, double expected, double tolerance = 1e-9) {
+    return std::fabs(value - expected) <= tolerance;
+}
+
+}  // namespace
+
+int main() {
+    for (bool swapped : {false, true}) {
+        Writer writer = grid_file(swapped);
+        check(writer.save(writer.size()), "write the grid");
+        NTv2Grid grid(path);
+        check(grid.valid(), swapped ? "swapped byte order is read" : "host byte order is read");
+
+        // 51.25N is 2.5 rows north of the south edge; 31.75E half a column west of the east edge.
+        double dB = 0;
+        double dL = 0;
+        check(grid.shift(Degree{51.25}, Degree{31.75}, dB, dL) && near(dB, 1 + 0.5 * 2.5) &&
+              near(dL, -(2 + 0.25 * 0.5)), "bilinear shift in the parent grid");
+        check(grid.shift(Degree{52}, Degree{30}, dB, dL) && near(dB, 1 + 0.5 * 4) && near(dL, -(2 + 0.25 * 4)),
+              "the north-west corner node");
+        check(grid.shift(Degree{50.75}, Degree{30.75}, dB, dL) && dB == 10 && dL == -20,
+              "points in the child grid use it");
+        check(grid.shift(Degree{50.5}, Degree{31}, dB, dL) && dB == 10 && dL == -20,
+              "the child's edges belong to the child");
+        check(grid.shift(Degree{50.49}, Degree{30.75}, dB, dL) && near(dB, 1 + 0.5 * 0.98),
+              "just outside the child falls back to the parent");
+        check(!grid.shift(Degree{49.99}, Degree{31}, dB, dL) && !grid.shift(Degree{51}, Degree{32.01}, dB, dL),
+              "points outside every grid have no shift");
+
+        SK42 sk_42{Degree{51.3}, Degree{30.2}, 120};
+        WGS84 wgs_84 = grid.to_wgs84(sk_42);
+        grid.shift(Degree{51.3}, Degree{30.2}, dB, dL);
+        check(wgs_84.latitude == sk_42.latitude + dB / 3600 && wgs_84.longitude == sk_42.longitude + dL / 3600 &&
+              wgs_84.altitude == 120, "forward shift");
+        SK42 back = grid.to_sk42(wgs_84);
+        check(near(back.latitude, 51.3, 1e-12) && near(back.longitude, 30.2, 1e-12), "the inverse undoes the shift");
+        std::vector<WGS84> outside = grid.to_wgs84(std::vector<SK42>{SK42{Degree{40}, Degree{30}, 0}});
+        check(std::isnan(outside[0].latitude) && std::isnan(outside[0].longitude), "outside the grid is NaN");
+    }
+
+    // Truncated node data and a file too short for the overview are rejected.
+    Writer writer = grid_file(false);
+    check(writer.save(writer.size() - 16) && !NTv2Grid(path).valid(), "truncated file");
+    Writer wrong(false);
+    wrong.record("NUM_OREC", std::int32_t{11});
+    check(wrong.save(wrong.size()) && !NTv2Grid(path).valid(), "short file");
+
+    std::remove(path);
+    return report();
+}
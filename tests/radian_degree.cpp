@@ -0,0 +1,75 @@
+#include "check.h"
+#include "radian_degree.h"
+
+#include <cmath>
+#include <string>
+
+namespace {
+
+bool parses_to(const std::string &text, double expected) {
+    double degrees = 0;
+    return parse_dms(text, degrees) && std::fabs(degrees - expected) < 1e-12;
+}
+
+bool rejects(const std::string &text) {
+    double degrees = 12345;
+    return !parse_dms(text, degrees) && degrees == 12345;
+}
+
+}  // namespace
+
+int main() {
+    double dms = 55 + 45. / 60 + 30.5 / 3600;
+    check(parses_to("55 45 30.5", dms), "space-separated");
+    check(parses_to("55\xc2\xb0" "45'30.5\"N", dms), "degree, minute and second signs with N");
+    check(parses_to("  55:45:30.5 ", dms), "colons and surrounding blanks");
+    check(parses_to("-37:36:59", -(37 + 36. / 60 + 59. / 3600)), "leading minus");
+    check(parses_to("+37.5", 37.5), "leading plus");
+    check(parses_to("151 12 30 E", 151 + 12. / 60 + 30. / 3600), "E stays positive");
+    check(parses_to("33 52 s", -(33 + 52. / 60)), "trailing s is south");
+    check(parses_to("70W", -70), "W directly after the number");
+    check(parses_to("359.999", 359.999), "degrees just below 360");
+
+    check(rejects(""), "empty");
+    check(rejects("N"), "hemisphere without numbers");
+    check(rejects("x5y"), "unexpected characters");
+    check(rejects("55 45 30.5 Nx"), "trailing garbage");
+    check(rejects("W 55 45"), "hemisphere before the numbers");
+    check(rejects("55 S 45"), "hemisphere between the numbers");
+    check(rejects("55 45 N S"), "two hemispheres");
+    check(rejects("-55 S"), "sign and hemisphere together");
+    check(rejects("55 -45"), "minus after the first number");
+    check(rejects("1e2"), "exponent");
+    check(rejects("5.5.5"), "numbers run together");
+    check(rejects("."), "a point without digits");
+    check(rejects("1 2 3 4"), "four numbers");
+    check(rejects("360"), "degrees of 360");
+    check(rejects("10 60"), "minutes of 60");
+    check(rejects("10 0 60"), "seconds of 60");
+
+    std::string texts[] = {"10 30", "bad", "20 S"};
+    double degrees[3] = {};
+    check(!parse_dms(texts, degrees, 3) && degrees[0] == 10.5 && degrees[2] == -20,
+          "the array form converts every valid entry and reports failure");
+
+    check(format_dms(dms, 1) == "55\xc2\xb0" "45'30.5\"", "format with one decimal");
+    check(format_dms(-(37 + 36. / 60 + 59. / 3600), 0) == "-37\xc2\xb0" "36'59\"", "negative angle");
+    check(format_dms(10 + 59. / 60 + 59.9996 / 3600) == "11\xc2\xb0" "0'0.000\"", "rounding carries into degrees");
+    bool round_trip = true;
+    for (int i = -3600; i <= 3600; ++i) {
+        double angle = i * 0.0497;
+        double parsed = 0;
+        round_trip = round_trip && parse_dms(format_dms(angle, 6), parsed) && std::fabs(parsed - angle) < 1e-9;
+    }
+    check(round_trip, "format_dms output parses back");
+
+    double in[] = {0, 90, -180, 45};
+    double out[4];
+    degrees_to_radians(in, out, 4);
+    check(out[0] == 0 && out[1] == 90 * radians_per_degree && out[2] == -pi && out[3] == Radian{Degree{45.}},
+          "degrees_to_radians matches the scalar conversion");
+    radians_to_degrees(out, out, 4);
+    check(out[1] == Degree{Radian{90 * radians_per_degree}} && out[2] == -180, "radians_to_degrees in place");
+
+    return report();
+}
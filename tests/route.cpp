@@ -0,0 +1,80 @@
+#include "check.h"
+#include "ecef.h"
+#include "route.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+bool same(double a, double b) {
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+}  // namespace
+
+int main() {
+    // More than one block, across zones and both hemispheres.
+    std::vector<PZ90> pz_90;
+    for (int i = 0; i < 1000; ++i) {
+        pz_90.push_back(PZ90{Degree{-70 + 0.14 * i}, Degree{-170 + 0.34 * i}, 10.0 * i});
+    }
+
+    std::vector<Coordinates> points;
+    for (const PZ90 &point : pz_90) {
+        points.push_back(Coordinates{{point.latitude, point.longitude, point.altitude}, 0, '\0'});
+    }
+    route(CRS::PZ90, CRS::UTM)(points);
+    bool matches = true;
+    for (std::size_t i = 0; i < pz_90.size(); ++i) {
+        UTM expected{WGS84{pz_90[i]}};
+        int number = 0;
+        char letter = 0;
+        UTM::parse_zone(expected.zone, number, letter);
+        matches = matches && same(points[i].values[0], expected.E) && same(points[i].values[1], expected.N) &&
+                  same(points[i].values[2], expected.altitude) && points[i].zone_number == number &&
+                  points[i].zone_letter == letter;
+    }
+    check(matches, "PZ90 -> UTM route matches the constructors");
+
+    // The column form gives the same result as the point form.
+    std::vector<double> columns[3];
+    std::vector<std::int32_t> zone_number(points.size());
+    std::vector<char> zone_letter(points.size());
+    for (const Coordinates &point : points) {
+        for (int k = 0; k < 3; ++k) {
+            columns[k].push_back(point.values[k]);
+        }
+    }
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        zone_number[i] = points[i].zone_number;
+        zone_letter[i] = points[i].zone_letter;
+    }
+    route(CRS::UTM, CRS::SK42)(points);
+    CoordinateColumns view{{columns[0].data(), columns[1].data(), columns[2].data()}, zone_number.data(),
+                           zone_letter.data()};
+    route(CRS::UTM, CRS::SK42)(view, points.size());
+    matches = true;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        for (int k = 0; k < 3; ++k) {
+            matches = matches && same(columns[k][i], points[i].values[k]);
+        }
+        matches = matches && zone_number[i] == 0 && zone_letter[i] == '\0' && points[i].zone_number == 0;
+    }
+    check(matches, "column and point forms agree and clear the zone");
+
+    // Routes that never touch UTM take no zone columns.
+    double latitude = 55.75;
+    double longitude = 37.62;
+    double height = 150;
+    route(CRS::WGS84, CRS::ECEF)(CoordinateColumns{{&latitude, &longitude, &height}, nullptr, nullptr}, 1);
+    ECEF ecef{WGS84{Degree{55.75}, Degree{37.62}, 150}};
+    check(latitude == ecef.x && longitude == ecef.y && height == ecef.z, "WGS84 -> ECEF without zone columns");
+
+    // A zone that does not parse converts to NaN, as with the UTM constructor.
+    Coordinates bad{{500000, 6000000, 0}, 0, '\0'};
+    route(CRS::UTM, CRS::WGS84)(&bad, 1);
+    check(std::isnan(bad.values[0]) && std::isnan(bad.values[1]), "invalid zone gives NaN");
+
+    return report();
+}
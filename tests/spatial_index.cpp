@@ -0,0 +1,80 @@
+#include "check.h"
+#include "spatial_index.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+double squared_distance(const GaussKruger &point, double x, double y) {
+    return (point.x - x) * (point.x - x) + (point.y - y) * (point.y - y);
+}
+
+}  // namespace
+
+// Queries against a brute-force scan, on enough points for the build to be
+// split across the thread pool.
+int main() {
+    std::mt19937_64 random(7);
+    std::uniform_real_distribution<double> x(6.0e6, 6.2e6);
+    std::uniform_real_distribution<double> y(7.3e6, 7.5e6);
+    std::vector<GaussKruger> points(50000);
+    for (GaussKruger &point : points) {
+        point.x = x(random);
+        point.y = y(random);
+        point.height = 0;
+    }
+    // Duplicates and collinear points, which put many ties on one split.
+    for (std::size_t i = 0; i < 200; ++i) {
+        points[i].x = 6.1e6;
+        points[i + 200] = points[i + 400];
+    }
+    SpatialIndex index(points);
+    check(index.size() == points.size(), "every point is indexed");
+
+    bool nearest = true;
+    for (int query = 0; query < 200; ++query) {
+        double qx = query < 10 ? 6.1e6 : x(random);
+        double qy = y(random);
+        for (std::size_t k : {std::size_t{1}, std::size_t{7}, std::size_t{64}}) {
+            std::vector<std::size_t> found = index.nearest(qx, qy, k);
+            std::vector<double> expected;
+            for (const GaussKruger &point : points) {
+                expected.push_back(squared_distance(point, qx, qy));
+            }
+            std::partial_sort(expected.begin(), expected.begin() + k, expected.end());
+            nearest = nearest && found.size() == k;
+            for (std::size_t i = 0; nearest && i < k; ++i) {
+                nearest = squared_distance(points[found[i]], qx, qy) == expected[i];
+            }
+        }
+    }
+    check(nearest, "nearest() matches a brute-force scan, nearest first");
+    check(index.nearest(6.1e6, 7.4e6, 0).empty(), "k = 0 finds nothing");
+    check(index.nearest(6.1e6, 7.4e6, points.size() + 5).size() == points.size(), "k past the size finds all");
+
+    bool within = true;
+    for (int query = 0; query < 200; ++query) {
+        double min_x = x(random);
+        double min_y = y(random);
+        double max_x = query < 10 ? 6.1e6 : min_x + 5000 * query;
+        double max_y = min_y + 3000 * query;
+        std::vector<std::size_t> found = index.within(min_x, min_y, max_x, max_y);
+        std::sort(found.begin(), found.end());
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            if (points[i].x >= min_x && points[i].x <= max_x && points[i].y >= min_y && points[i].y <= max_y) {
+                expected.push_back(i);
+            }
+        }
+        within = within && found == expected;
+    }
+    check(within, "within() matches a brute-force scan");
+
+    std::vector<UTM> empty;
+    check(SpatialIndex(empty).nearest(0, 0, 3).empty() && SpatialIndex(empty).within(0, 0, 1, 1).empty(),
+          "an empty index finds nothing");
+
+    return report();
+}
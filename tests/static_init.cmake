@@ -0,0 +1,27 @@
+# Fails if the object file built from transformations.cpp needs run-time
+# initialisation: a static initialiser (.init_array, _GLOBAL__sub_I_) or a
+# guarded function-local static (__cxa_guard_acquire).
+#
+#   cmake -DOBJDUMP=<objdump> -DOBJECTS=<object|object|...> -P static_init.cmake
+
+string(REPLACE "|" ";" objects "${OBJECTS}")
+list(FILTER objects INCLUDE REGEX "/transformations\\.cpp\\.o(bj)?$")
+if(NOT objects)
+    message(FATAL_ERROR "no object file for transformations.cpp in ${OBJECTS}")
+endif()
+
+execute_process(COMMAND ${OBJDUMP} --section-headers --reloc ${objects}
+    OUTPUT_VARIABLE dump ERROR_VARIABLE error RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${OBJDUMP} failed: ${error}")
+endif()
+# LTO objects without machine code would pass vacuously.
+if(NOT dump MATCHES "\\.text")
+    message(FATAL_ERROR "${objects} has no machine code to inspect")
+endif()
+foreach(pattern "\\.init_array" "_GLOBAL__sub_I_" "__cxa_guard_acquire")
+    if(dump MATCHES "${pattern}")
+        message(FATAL_ERROR "transformations.cpp needs run-time initialisation: found ${CMAKE_MATCH_0}")
+    endif()
+endforeach()
+message(STATUS "no run-time initialisation in ${objects}")
@@ -0,0 +1,81 @@
+#include "batch.h"
+#include "check.h"
+#include "stats.h"
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const RouteStats &stats(const Stats::Snapshot &snapshot, ROUTE route) {
+    return snapshot[static_cast<std::size_t>(route)];
+}
+
+std::string bucket_line(const char *route, const char *le) {
+    return std::string("transformations_batch_duration_seconds_bucket{route=\"") + route + "\",le=\"" + le + "\"} ";
+}
+
+std::uint64_t exported(const std::string &text, const std::string &line) {
+    std::size_t at = text.find(line);
+    return at == std::string::npos ? ~std::uint64_t{0} : std::stoull(text.substr(at + line.size()));
+}
+
+// Counts from its destructor. Constructed before a thread's first count, it is
+// destroyed after the thread has retired its shard.
+struct LateCounter {
+    ~LateCounter() { Stats::count(ROUTE::GEOID); }
+};
+
+}  // namespace
+
+int main() {
+    Stats::reset();
+
+    // Bucket bounds are inclusive, as Prometheus reads `le`: 2 ns goes in the
+    // le="0.000000002" bucket, 3 ns in le="0.000000004".
+    Stats::record(ROUTE::BATCH_ROUTE, 10, 2);
+    Stats::record(ROUTE::BATCH_ROUTE, 10, 3);
+    Stats::record(ROUTE::BATCH_ROUTE, 10, 4);
+    std::ostringstream text;
+    Stats::write_prometheus(text);
+    check(exported(text.str(), bucket_line("batch_route", "0.000000001")) == 0, "le=1ns bucket");
+    check(exported(text.str(), bucket_line("batch_route", "0.000000002")) == 1, "le=2ns bucket is inclusive");
+    check(exported(text.str(), bucket_line("batch_route", "0.000000004")) == 3, "le=4ns bucket is inclusive");
+    check(exported(text.str(), bucket_line("batch_route", "+Inf")) == 3, "le=+Inf bucket");
+    check(text.str().find("batch_duration_seconds_bucket{route=\"helmert\"") == std::string::npos,
+          "single-point routes have no histogram");
+
+    // Shards of running and finished threads are both merged.
+    std::vector<WGS84> points(100, WGS84{Degree{55.75}, Degree{37.62}, 150});
+    Stats::reset();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&points] { to_utm(points); });
+    }
+    to_utm(points);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    Stats::Snapshot snapshot = Stats::snapshot();
+    check(stats(snapshot, ROUTE::BATCH_TO_UTM).timed_calls == 5, "batch calls from five threads");
+    check(stats(snapshot, ROUTE::BATCH_TO_UTM).points == 500, "batch points from five threads");
+    check(stats(snapshot, ROUTE::UTM_FROM_WGS84).points == 500, "single-point counts from five threads");
+    check(stats(snapshot, ROUTE::UTM_FROM_WGS84).timed_calls == 0, "single points are not timed");
+
+    Stats::reset();
+    std::thread([] {
+        thread_local LateCounter late;
+        static_cast<void>(late);
+        Stats::count(ROUTE::GEOID);
+    }).join();
+    check(stats(Stats::snapshot(), ROUTE::GEOID).points == 2, "counts after the shard is retired");
+
+    Stats::reset();
+    snapshot = Stats::snapshot();
+    check(stats(snapshot, ROUTE::BATCH_TO_UTM).points == 0, "reset clears merged shards");
+    check(stats(snapshot, ROUTE::BATCH_TO_UTM).histogram[RouteStats::buckets] == 0, "reset clears histograms");
+
+    return report();
+}
@@ -0,0 +1,38 @@
+#include "check.h"
+#include "utm_series.h"
+
+#include <cmath>
+
+// Each compile-time constant against the expression it replaced, evaluated at
+// run time with libm. volatile keeps the compiler from folding them.
+int main() {
+    volatile double a_ = WGS84::_a;
+    volatile double e2_ = WGS84::_e2;
+    double a = a_;
+    double e2 = e2_;
+
+    check(utm_series::ep2 == e2 / (1 - e2), "ep2");
+    check(utm_series::m0 == 1 - e2 / 4 - (3. / 64) * std::pow(e2, 2) - (5. / 256) * std::pow(e2, 3), "m0");
+    check(utm_series::m2 == (3. / 8) * e2 + (3. / 32) * std::pow(e2, 2) + (45. / 1024) * std::pow(e2, 3), "m2");
+    check(utm_series::m4 == (15. / 256) * std::pow(e2, 2) + (45. / 1024) * std::pow(e2, 3), "m4");
+    check(utm_series::m6 == (35. / 3072) * std::pow(e2, 3), "m6");
+    check(utm_series::mu_scale == a * (1 - e2 / 4 - 3 * e2 * e2 / 64 - 5 * e2 * e2 * e2 / 256), "mu_scale");
+
+    double root = std::sqrt(1 - e2);
+    check(utm_series::root == root, "sqrt_near_one(1 - e^2) is std::sqrt");
+    double e1 = (1 - root) / (1 + root);
+    check(utm_series::e1 == e1, "e1");
+    check(utm_series::phi2 == 3 * e1 / 2 - (27. / 32) * std::pow(e1, 3) / 32, "phi2");
+    check(utm_series::phi4 == (21. / 16) * std::pow(e1, 2) - (55. / 32) * std::pow(e1, 4), "phi4");
+    check(utm_series::phi6 == (151. / 96) * std::pow(e1, 3), "phi6");
+
+    // Correctly rounded over the range it is meant for, not just at 1 - e^2.
+    bool roots = true;
+    for (int i = 0; i <= 100000; ++i) {
+        volatile double x = 0.98 + 0.04 * i / 100000;
+        roots = roots && utm_series::sqrt_near_one(x) == std::sqrt(x);
+    }
+    check(roots, "sqrt_near_one matches std::sqrt on [0.98, 1.02]");
+
+    return report();
+}